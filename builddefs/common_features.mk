@@ -44,6 +44,24 @@ else ifeq ($(strip $(DEBUG_MATRIX_SCAN_RATE_ENABLE)), api)
     OPT_DEFS += -DDEBUG_MATRIX_SCAN_RATE
 endif
 
+ifeq ($(strip $(MATRIX_IDLE_WAIT_ENABLE)), yes)
+    ifeq ("$(wildcard $(PLATFORM_PATH)/$(PLATFORM_KEY)/wakeup.c)","")
+        $(call CATASTROPHIC_ERROR,Invalid MATRIX_IDLE_WAIT_ENABLE,MATRIX_IDLE_WAIT_ENABLE is not supported on the $(PLATFORM_KEY) platform)
+    endif
+    OPT_DEFS += -DMATRIX_IDLE_WAIT_ENABLE
+    SRC += $(PLATFORM_PATH)/$(PLATFORM_KEY)/wakeup.c
+endif
+
+ifeq ($(strip $(HOST_REPORT_QUEUE_ENABLE)), yes)
+    OPT_DEFS += -DHOST_REPORT_QUEUE_ENABLE
+endif
+
+ifeq ($(strip $(SEND_STRING_ASYNC_ENABLE)), yes)
+    OPT_DEFS += -DSEND_STRING_ASYNC_ENABLE
+    SEND_STRING_ENABLE := yes
+    DEFERRED_EXEC_ENABLE := yes
+endif
+
 AUDIO_ENABLE ?= no
 ifeq ($(strip $(AUDIO_ENABLE)), yes)
     ifeq ($(PLATFORM),CHIBIOS)
@@ -926,6 +944,12 @@ ifeq ($(strip $(DIP_SWITCH_ENABLE)), yes)
     endif
 endif
 
+ifeq ($(strip $(LEADER_ENABLE)), yes)
+    ifeq ($(strip $(LEADER_SEQUENCES_ENABLE)), yes)
+        OPT_DEFS += -DLEADER_SEQUENCES_ENABLE
+    endif
+endif
+
 VALID_WS2812_DRIVER_TYPES := bitbang custom i2c pwm spi vendor
 
 WS2812_DRIVER ?= bitbang
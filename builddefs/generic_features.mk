@@ -34,6 +34,7 @@ GENERIC_FEATURES = \
     DYNAMIC_TAPPING_TERM \
     GRAVE_ESC \
     HAPTIC \
+    KEY_EVENT_QUEUE \
     KEY_LOCK \
     KEY_OVERRIDE \
     LEADER \
@@ -49,6 +50,8 @@ GENERIC_FEATURES = \
     SPACE_CADET \
     SWAP_HANDS \
     TAP_DANCE \
+    TASK_PROFILER \
+    TASK_SCHEDULER \
     TRI_LAYER \
     VIA \
     VIRTSER \
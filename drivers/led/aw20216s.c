@@ -21,6 +21,9 @@
 
 #define AW20216S_PWM_REGISTER_COUNT 216
 
+// Dirty bit of the 24 byte chunk holding a PWM register in aw20216s_update_pwm_buffers()
+#define AW20216S_PWM_DIRTY_BIT(reg) (1 << ((reg) / 24))
+
 #ifndef AW20216S_CONFIGURATION
 #    define AW20216S_CONFIGURATION (AW20216S_CONFIGURATION_SWSEL_1_12 | AW20216S_CONFIGURATION_CHIPEN)
 #endif
@@ -46,13 +49,13 @@
 #endif
 
 typedef struct aw20216s_driver_t {
-    uint8_t pwm_buffer[AW20216S_PWM_REGISTER_COUNT];
-    bool    pwm_buffer_dirty;
+    uint8_t  pwm_buffer[AW20216S_PWM_REGISTER_COUNT];
+    uint16_t pwm_buffer_dirty;
 } PACKED aw20216s_driver_t;
 
 aw20216s_driver_t driver_buffers[AW20216S_DRIVER_COUNT] = {{
     .pwm_buffer       = {0},
-    .pwm_buffer_dirty = false,
+    .pwm_buffer_dirty = 0,
 }};
 
 bool aw20216s_write(pin_t cs_pin, uint8_t page, uint8_t reg, uint8_t* data, uint8_t len) {
@@ -147,7 +150,7 @@ void aw20216s_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
     driver_buffers[led.driver].pwm_buffer[led.r] = red;
     driver_buffers[led.driver].pwm_buffer[led.g] = green;
     driver_buffers[led.driver].pwm_buffer[led.b] = blue;
-    driver_buffers[led.driver].pwm_buffer_dirty  = true;
+    driver_buffers[led.driver].pwm_buffer_dirty |= AW20216S_PWM_DIRTY_BIT(led.r) | AW20216S_PWM_DIRTY_BIT(led.g) | AW20216S_PWM_DIRTY_BIT(led.b);
 }
 
 void aw20216s_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
@@ -157,10 +160,22 @@ void aw20216s_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
 }
 
 void aw20216s_update_pwm_buffers(pin_t cs_pin, uint8_t index) {
-    if (driver_buffers[index].pwm_buffer_dirty) {
-        aw20216s_write(cs_pin, AW20216S_PAGE_PWM, 0, driver_buffers[index].pwm_buffer, AW20216S_PWM_REGISTER_COUNT);
-        driver_buffers[index].pwm_buffer_dirty = false;
+    // Transmit only the runs of dirty chunks, each as a single transfer.
+    uint8_t i = 0;
+    while (i < AW20216S_PWM_REGISTER_COUNT) {
+        if (!(driver_buffers[index].pwm_buffer_dirty & AW20216S_PWM_DIRTY_BIT(i))) {
+            i += 24;
+            continue;
+        }
+
+        uint8_t start = i;
+        do {
+            i += 24;
+        } while (i < AW20216S_PWM_REGISTER_COUNT && (driver_buffers[index].pwm_buffer_dirty & AW20216S_PWM_DIRTY_BIT(i)));
+
+        aw20216s_write(cs_pin, AW20216S_PAGE_PWM, start, driver_buffers[index].pwm_buffer + start, i - start);
     }
+    driver_buffers[index].pwm_buffer_dirty = 0;
 }
 
 void aw20216s_flush(void) {
@@ -27,6 +27,7 @@ Example:
 For full documentation, see QMK Docs
 """
 
+import struct
 import textwrap
 from typing import Any, Dict, Iterator, List, Tuple
 
@@ -49,6 +50,10 @@ TYPO_CHARS = dict([
 ] + [(chr(c), c + KC_A - ord('a')) for c in range(ord('a'),
                                                   ord('z') + 1)])  # Characters a-z.
 
+# Child order of the bitmap trie, bit n of a node's bitmap stands for BITMAP_CHARS[n].
+BITMAP_CHARS = 'abcdefghijklmnopqrstuvwxyz\':'
+BITMAP_MATCH = 1 << 31
+
 
 def parse_file(file_name: str) -> List[Tuple[str, str]]:
     """Parses autocorrections dictionary file.
@@ -165,6 +170,24 @@ def check_typo_against_dictionary(typo: str, line_number: int, correct_words) ->
                 cli.log.warning('{fg_yellow}Warning:%d:{fg_reset} Typo "{fg_cyan}%s{fg_reset}" would falsely trigger on correctly spelled word "{fg_cyan}%s{fg_reset}".', line_number, typo, word)
 
 
+def make_correction(typo: str, correction: str) -> Tuple[int, str]:
+    """Works out the edit that turns `typo` into `correction`.
+  Args:
+    typo: String, the typo including its word break characters.
+    correction: String, the corrected word.
+  Returns:
+    Tuple of the number of backspaces to send and the string to type after them.
+  """
+    word_boundary_ending = typo[-1] == ':'
+    typo = typo.strip(':')
+    i = 0
+    while i < min(len(typo), len(correction)) and typo[i] == correction[i]:
+        i += 1
+    backspaces = len(typo) - i - 1 + word_boundary_ending
+    assert 0 <= backspaces <= 63
+    return backspaces, correction[i:]
+
+
 def serialize_trie(autocorrections: List[Tuple[str, str]], trie: Dict[str, Any]) -> List[int]:
     """Serializes trie and correction data in a form readable by the C code.
   Args:
@@ -178,15 +201,7 @@ def serialize_trie(autocorrections: List[Tuple[str, str]], trie: Dict[str, Any])
     # Traverse trie in depth first order.
     def traverse(trie_node):
         if 'LEAF' in trie_node:  # Handle a leaf trie node.
-            typo, correction = trie_node['LEAF']
-            word_boundary_ending = typo[-1] == ':'
-            typo = typo.strip(':')
-            i = 0  # Make the autocorrection data for this entry and serialize it.
-            while i < min(len(typo), len(correction)) and typo[i] == correction[i]:
-                i += 1
-            backspaces = len(typo) - i - 1 + word_boundary_ending
-            assert 0 <= backspaces <= 63
-            correction = correction[i:]
+            backspaces, correction = make_correction(*trie_node['LEAF'])
             bs_count = [backspaces + 128]
             data = bs_count + list(bytes(correction, 'ascii')) + [0]
 
@@ -232,11 +247,42 @@ def serialize_trie(autocorrections: List[Tuple[str, str]], trie: Dict[str, Any])
     return [b for e in table for b in serialize(e)]  # Serialize final table.
 
 
+def serialize_bitmap_trie(trie: Dict[str, Any]) -> Tuple[List[int], List[int]]:
+    """Serializes trie into the bitmap format readable by the C code.
+  Nodes are numbered in breadth first order, so that the children of a node are
+  stored next to each other. Each node is a pair of 32-bit words: the bitmap of
+  its children and the index of its first child. The child for a character is
+  then found by counting the bits set below that character's bit. Leaf nodes
+  instead have BITMAP_MATCH set and point into the corrections table, which
+  holds the number of backspaces followed by a null terminated string.
+  Args:
+    trie: Dict of dicts.
+  Returns:
+    Tuple of the list of node words and the list of correction bytes.
+  """
+    nodes = []
+    corrections = []
+    queue = [trie]
+
+    for trie_node in queue:
+        if 'LEAF' in trie_node:
+            assert len(trie_node) == 1
+            backspaces, correction = make_correction(*trie_node['LEAF'])
+            nodes += [BITMAP_MATCH, len(corrections)]
+            corrections += [backspaces] + list(bytes(correction, 'ascii')) + [0]
+        else:
+            chars = sorted(trie_node.keys(), key=BITMAP_CHARS.index)
+            nodes += [sum(1 << BITMAP_CHARS.index(c) for c in chars), len(queue)]
+            queue += [trie_node[c] for c in chars]
+
+    return nodes, corrections
+
+
 def encode_link(link: Dict[str, Any]) -> List[int]:
     """Encodes a node link as two bytes."""
     byte_offset = link['byte_offset']
     if not (0 <= byte_offset <= 0xffff):
-        cli.log.error('{fg_red}Error:{fg_reset} The autocorrection table is too large, a node link exceeds 64KB limit. Try reducing the autocorrection dict to fewer entries.')
+        cli.log.error('{fg_red}Error:{fg_reset} The autocorrection table is too large, a node link exceeds 64KB limit. Try reducing the autocorrection dict to fewer entries, or use `--format bitmap`.')
         maybe_exit(1)
     return [byte_offset & 255, byte_offset >> 8]
 
@@ -249,16 +295,25 @@ def to_hex(b: int) -> str:
     return f'0x{b:02X}'
 
 
+def to_hex32(w: int) -> str:
+    return f'0x{w:08X}'
+
+
 @cli.argument('filename', type=normpath, help='The autocorrection database file')
 @cli.argument('-kb', '--keyboard', type=keyboard_folder, completer=keyboard_completer, help='The keyboard to build a firmware for. Ignored when a configurator export is supplied.')
 @cli.argument('-km', '--keymap', completer=keymap_completer, help='The keymap to build a firmware for. Ignored when a configurator export is supplied.')
 @cli.argument('-o', '--output', arg_only=True, type=normpath, help='File to write to')
+@cli.argument('-f', '--format', arg_only=True, choices=['packed', 'bitmap'], default='packed', help='The trie format, "bitmap" scales to large dictionaries. Default: packed')
+@cli.argument('-b', '--binary', arg_only=True, type=normpath, help='Also write the bitmap trie to this file as an image for external flash')
 @cli.argument('-q', '--quiet', arg_only=True, action='store_true', help="Quiet mode, only output error messages")
 @cli.subcommand('Generate the autocorrection data file from a dictionary file.')
 def generate_autocorrect_data(cli):
+    if cli.args.binary and cli.args.format != 'bitmap':
+        cli.log.error('{fg_red}Error:{fg_reset} A flash image can only be written for `--format bitmap`.')
+        return False
+
     autocorrections = parse_file(cli.args.filename)
     trie = make_trie(autocorrections)
-    data = serialize_trie(autocorrections, trie)
 
     current_keyboard = cli.args.keyboard or cli.config.user.keyboard or cli.config.generate_autocorrect_data.keyboard
     current_keymap = cli.args.keymap or cli.config.user.keymap or cli.config.generate_autocorrect_data.keymap
@@ -266,8 +321,6 @@ def generate_autocorrect_data(cli):
     if current_keyboard and current_keymap:
         cli.args.output = locate_keymap(current_keyboard, current_keymap).parent / 'autocorrect_data.h'
 
-    assert all(0 <= b <= 255 for b in data)
-
     min_typo = min(autocorrections, key=typo_len)[0]
     max_typo = max(autocorrections, key=typo_len)[0]
 
@@ -281,11 +334,43 @@ def generate_autocorrect_data(cli):
     autocorrect_data_h_lines.append('')
     autocorrect_data_h_lines.append(f'#define AUTOCORRECT_MIN_LENGTH {len(min_typo)} // "{min_typo}"')
     autocorrect_data_h_lines.append(f'#define AUTOCORRECT_MAX_LENGTH {len(max_typo)} // "{max_typo}"')
-    autocorrect_data_h_lines.append(f'#define DICTIONARY_SIZE {len(data)}')
-    autocorrect_data_h_lines.append('')
-    autocorrect_data_h_lines.append('static const uint8_t autocorrect_data[DICTIONARY_SIZE] PROGMEM = {')
-    autocorrect_data_h_lines.append(textwrap.fill('    %s' % (', '.join(map(to_hex, data))), width=100, subsequent_indent='    '))
-    autocorrect_data_h_lines.append('};')
+
+    if cli.args.format == 'bitmap':
+        nodes, corrections = serialize_bitmap_trie(trie)
+        max_correction = max(len(make_correction(typo, correction)[1]) for typo, correction in autocorrections)
+
+        assert all(0 <= b <= 255 for b in corrections)
+
+        autocorrect_data_h_lines.append(f'#define AUTOCORRECT_MAX_CORRECTION_LENGTH {max_correction}')
+        autocorrect_data_h_lines.append('#define AUTOCORRECT_BITMAP_TRIE')
+        autocorrect_data_h_lines.append(f'#define AUTOCORRECT_TRIE_NODES {len(nodes) // 2}')
+        autocorrect_data_h_lines.append(f'#define AUTOCORRECT_CORRECTIONS_SIZE {len(corrections)}')
+        autocorrect_data_h_lines.append('')
+        autocorrect_data_h_lines.append('#ifndef AUTOCORRECT_FLASH_OFFSET')
+        autocorrect_data_h_lines.append('static const uint32_t autocorrect_trie[AUTOCORRECT_TRIE_NODES * 2] PROGMEM = {')
+        autocorrect_data_h_lines.append(textwrap.fill('    %s' % (', '.join(map(to_hex32, nodes))), width=100, subsequent_indent='    '))
+        autocorrect_data_h_lines.append('};')
+        autocorrect_data_h_lines.append('')
+        autocorrect_data_h_lines.append('static const uint8_t autocorrect_corrections[AUTOCORRECT_CORRECTIONS_SIZE] PROGMEM = {')
+        autocorrect_data_h_lines.append(textwrap.fill('    %s' % (', '.join(map(to_hex, corrections))), width=100, subsequent_indent='    '))
+        autocorrect_data_h_lines.append('};')
+        autocorrect_data_h_lines.append('#endif')
+
+        if cli.args.binary:
+            # Little endian node words followed by the corrections, as read back by process_autocorrect.c
+            cli.args.binary.write_bytes(struct.pack(f'<{len(nodes)}I', *nodes) + bytes(corrections))
+            if not cli.args.quiet:
+                cli.log.info('Wrote flash image to %s.', cli.args.binary)
+    else:
+        data = serialize_trie(autocorrections, trie)
+
+        assert all(0 <= b <= 255 for b in data)
+
+        autocorrect_data_h_lines.append(f'#define DICTIONARY_SIZE {len(data)}')
+        autocorrect_data_h_lines.append('')
+        autocorrect_data_h_lines.append('static const uint8_t autocorrect_data[DICTIONARY_SIZE] PROGMEM = {')
+        autocorrect_data_h_lines.append(textwrap.fill('    %s' % (', '.join(map(to_hex, data))), width=100, subsequent_indent='    '))
+        autocorrect_data_h_lines.append('};')
 
     # Show the results
     dump_lines(cli.args.output, autocorrect_data_h_lines, cli.args.quiet)
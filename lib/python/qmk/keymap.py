@@ -64,6 +64,24 @@ def _generate_encodermap_table(keymap_json):
     return lines
 
 
+def _generate_leader_sequences_table(keymap_json):
+    lines = ['#if defined(LEADER_ENABLE) && defined(LEADER_SEQUENCES_ENABLE)']
+    for i, leader_sequence in enumerate(keymap_json['leader_sequences']):
+        keys = ', '.join(map(_strip_any, leader_sequence['sequence']))
+        lines.append(f'const uint16_t PROGMEM leader_sequence_{i}[] = {{{keys}, LEADER_SEQUENCE_END}};')
+    lines.append('')
+    lines.append('const leader_sequence_t PROGMEM leader_sequences[] = {')
+    for i, leader_sequence in enumerate(keymap_json['leader_sequences']):
+        if 'keycode' in leader_sequence:
+            lines.append(f'    LEADER_SEQUENCE(leader_sequence_{i}, {_strip_any(leader_sequence["keycode"])}),')
+        else:
+            lines.append(f'    LEADER_SEQUENCE_ACTION(leader_sequence_{i}),')
+    lines.append('};')
+    lines.append('#endif // defined(LEADER_ENABLE) && defined(LEADER_SEQUENCES_ENABLE)')
+    lines.append('')
+    return lines
+
+
 def _generate_macros_function(keymap_json):
     macro_txt = [
         'bool process_record_user(uint16_t keycode, keyrecord_t *record) {',
@@ -269,6 +287,9 @@ def generate_c(keymap_json):
 
         macros
             A sequence of strings containing macros to implement for this keyboard.
+
+        leader_sequences
+            A sequence of objects with the `sequence` of keycodes to type after the leader key, and the `keycode` to tap once they are typed.
     """
     new_keymap = DEFAULT_KEYMAP_C
     layer_txt = _generate_keymap_table(keymap_json)
@@ -282,9 +303,12 @@ def generate_c(keymap_json):
     new_keymap = new_keymap.replace('__ENCODER_MAP_GOES_HERE__', encodermap)
 
     macros = ''
+    if 'leader_sequences' in keymap_json and keymap_json['leader_sequences'] is not None:
+        leader_txt = _generate_leader_sequences_table(keymap_json)
+        macros += '\n'.join(leader_txt) + '\n'
     if 'macros' in keymap_json and keymap_json['macros'] is not None:
         macro_txt = _generate_macros_function(keymap_json)
-        macros = '\n'.join(macro_txt)
+        macros += '\n'.join(macro_txt)
     new_keymap = new_keymap.replace('__MACRO_OUTPUT_GOES_HERE__', macros)
 
     hostlang = ''
@@ -34,6 +34,29 @@ const uint16_t PROGMEM encoder_map[][NUM_ENCODERS][NUM_DIRECTIONS] = {
 """
 
 
+def test_generate_c_leader_sequences():
+    keymap_json = {
+        'keyboard': 'handwired/pytest/basic',
+        'layout': 'LAYOUT',
+        'layers': [['QK_LEAD']],
+        'leader_sequences': [
+            {'sequence': ['KC_G', 'KC_S'], 'keycode': 'KC_F1'},
+            {'sequence': ['KC_X']},
+        ],
+    }
+    templ = qmk.keymap.generate_c(keymap_json)
+    assert """#if defined(LEADER_ENABLE) && defined(LEADER_SEQUENCES_ENABLE)
+const uint16_t PROGMEM leader_sequence_0[] = {KC_G, KC_S, LEADER_SEQUENCE_END};
+const uint16_t PROGMEM leader_sequence_1[] = {KC_X, LEADER_SEQUENCE_END};
+
+const leader_sequence_t PROGMEM leader_sequences[] = {
+    LEADER_SEQUENCE(leader_sequence_0, KC_F1),
+    LEADER_SEQUENCE_ACTION(leader_sequence_1),
+};
+#endif // defined(LEADER_ENABLE) && defined(LEADER_SEQUENCES_ENABLE)
+""" in templ
+
+
 def test_generate_json_pytest_basic():
     templ = qmk.keymap.generate_json('default', 'handwired/pytest/basic', 'LAYOUT', [['KC_A']])
     assert templ == {"keyboard": "handwired/pytest/basic", "keymap": "default", "layout": "LAYOUT", "layers": [["KC_A"]]}
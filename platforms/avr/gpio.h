@@ -36,3 +36,13 @@ typedef uint8_t pin_t;
 #define gpio_read_pin(pin) ((bool)(PINx_ADDRESS(pin) & _BV((pin)&0xF)))
 
 #define gpio_toggle_pin(pin) (PORTx_ADDRESS(pin) ^= _BV((pin)&0xF))
+
+/* Operation of GPIO by port. */
+
+typedef uint8_t gpio_port_t;
+typedef uint8_t gpio_port_state_t;
+
+#define gpio_pin_port(pin) ((gpio_port_t)((pin) >> PORT_SHIFTER))
+#define gpio_pin_pad(pin) ((pin)&0xF)
+
+#define gpio_read_port(port) ((gpio_port_state_t)_SFR_IO8(ADDRESS_BASE + (port)))
@@ -1,4 +1,6 @@
+#include <ch.h>
 #include "ws2812.h"
+#include "ws2812_spi_encode.h"
 #include "gpio.h"
 #include "util.h"
 #include "chibios_config.h"
@@ -86,54 +88,50 @@
 #define RESET_SIZE (1000 * WS2812_TRST_US / (2 * WS2812_TIMING))
 #define PREAMBLE_SIZE 4
 
-static uint8_t txbuf[PREAMBLE_SIZE + DATA_SIZE + RESET_SIZE] = {0};
-
-/*
- * As the trick here is to use the SPI to send a huge pattern of 0 and 1 to
- * the ws2812b protocol, we use this helper function to translate bytes into
- * 0s and 1s for the LED (with the appropriate timing).
- */
-static uint8_t get_protocol_eq(uint8_t data, int pos) {
-    uint8_t eq = 0;
-    if (data & (1 << (2 * (3 - pos))))
-        eq = 0b1110;
-    else
-        eq = 0b1000;
-    if (data & (2 << (2 * (3 - pos))))
-        eq += 0b11100000;
-    else
-        eq += 0b10000000;
-    return eq;
+// Unless the SPI sends synchronously or keeps repeating a single buffer,
+// the next frame is encoded into one buffer while the other is being sent.
+#if defined(WS2812_SPI_USE_CIRCULAR_BUFFER) || defined(WS2812_SPI_SYNC)
+#    define TXBUF_COUNT 1
+#else
+#    define TXBUF_COUNT 2
+#endif
+
+static uint8_t txbuf[TXBUF_COUNT][PREAMBLE_SIZE + DATA_SIZE + RESET_SIZE] = {0};
+static uint8_t txbuf_back;
+
+#if TXBUF_COUNT == 2
+// Taken while a frame is being sent, given back by the SPI completion interrupt
+static BSEMAPHORE_DECL(txbuf_sent, false);
+
+static void txbuf_sent_callback(SPIDriver* spip) {
+    (void)spip;
+    osalSysLockFromISR();
+    chBSemSignalI(&txbuf_sent);
+    osalSysUnlockFromISR();
 }
+#    define WS2812_SPI_END_CB txbuf_sent_callback
+#else
+#    define WS2812_SPI_END_CB NULL
+#endif
 
 static void set_led_color_rgb(rgb_led_t color, int pos) {
-    uint8_t* tx_start = &txbuf[PREAMBLE_SIZE];
+    uint8_t* tx_start = &txbuf[txbuf_back][PREAMBLE_SIZE + BYTES_FOR_LED * pos];
 
 #if (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_GRB)
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + j] = get_protocol_eq(color.g, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE + j] = get_protocol_eq(color.r, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 2 + j] = get_protocol_eq(color.b, j);
+    ws2812_spi_encode_byte(tx_start, color.g);
+    ws2812_spi_encode_byte(tx_start + BYTES_FOR_LED_BYTE, color.r);
+    ws2812_spi_encode_byte(tx_start + BYTES_FOR_LED_BYTE * 2, color.b);
 #elif (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_RGB)
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + j] = get_protocol_eq(color.r, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE + j] = get_protocol_eq(color.g, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 2 + j] = get_protocol_eq(color.b, j);
+    ws2812_spi_encode_byte(tx_start, color.r);
+    ws2812_spi_encode_byte(tx_start + BYTES_FOR_LED_BYTE, color.g);
+    ws2812_spi_encode_byte(tx_start + BYTES_FOR_LED_BYTE * 2, color.b);
 #elif (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_BGR)
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + j] = get_protocol_eq(color.b, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE + j] = get_protocol_eq(color.g, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 2 + j] = get_protocol_eq(color.r, j);
+    ws2812_spi_encode_byte(tx_start, color.b);
+    ws2812_spi_encode_byte(tx_start + BYTES_FOR_LED_BYTE, color.g);
+    ws2812_spi_encode_byte(tx_start + BYTES_FOR_LED_BYTE * 2, color.r);
 #endif
 #ifdef WS2812_RGBW
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 3 + j] = get_protocol_eq(color.w, j);
+    ws2812_spi_encode_byte(tx_start + BYTES_FOR_LED_BYTE * 3, color.w);
 #endif
 }
 
@@ -151,7 +149,7 @@ void ws2812_init(void) {
 #    if SPI_SUPPORTS_CIRCULAR == TRUE
         WS2812_SPI_BUFFER_MODE,
 #    endif
-        NULL, // end_cb
+        WS2812_SPI_END_CB, // end_cb
         PAL_PORT(WS2812_DI_PIN),
         PAL_PAD(WS2812_DI_PIN),
 #    if defined(WB32F3G71xx) || defined(WB32FQ95xx)
@@ -170,7 +168,7 @@ void ws2812_init(void) {
 #    if SPI_SUPPORTS_SLAVE_MODE == TRUE
         false,
 #    endif
-        NULL, // data_cb
+        WS2812_SPI_END_CB, // data_cb
         NULL, // error_cb
         PAL_PORT(WS2812_DI_PIN),
         PAL_PAD(WS2812_DI_PIN),
@@ -183,22 +181,24 @@ void ws2812_init(void) {
     spiStart(&WS2812_SPI_DRIVER, &spicfg); /* Setup transfer parameters.       */
     spiSelect(&WS2812_SPI_DRIVER);         /* Slave Select assertion.          */
 #ifdef WS2812_SPI_USE_CIRCULAR_BUFFER
-    spiStartSend(&WS2812_SPI_DRIVER, ARRAY_SIZE(txbuf), txbuf);
+    spiStartSend(&WS2812_SPI_DRIVER, ARRAY_SIZE(txbuf[0]), txbuf[0]);
 #endif
 }
 
 void ws2812_setleds(rgb_led_t* ledarray, uint16_t leds) {
-    for (uint8_t i = 0; i < leds; i++) {
+    for (uint16_t i = 0; i < leds; i++) {
         set_led_color_rgb(ledarray[i], i);
     }
 
-    // Send async - each led takes ~0.03ms, 50 leds ~1.5ms, animations flushing faster than send will cause issues.
-    // Instead spiSend can be used to send synchronously (or the thread logic can be added back).
 #ifndef WS2812_SPI_USE_CIRCULAR_BUFFER
 #    ifdef WS2812_SPI_SYNC
-    spiSend(&WS2812_SPI_DRIVER, ARRAY_SIZE(txbuf), txbuf);
+    spiSend(&WS2812_SPI_DRIVER, ARRAY_SIZE(txbuf[0]), txbuf[0]);
 #    else
-    spiStartSend(&WS2812_SPI_DRIVER, ARRAY_SIZE(txbuf), txbuf);
+    // Send async - each led takes ~0.03ms, 50 leds ~1.5ms. The colors above went into the buffer
+    // not being sent, so this only waits when animations flush faster than the previous frame is sent.
+    chBSemWait(&txbuf_sent);
+    spiStartSend(&WS2812_SPI_DRIVER, ARRAY_SIZE(txbuf[0]), txbuf[txbuf_back]);
+    txbuf_back ^= 1;
 #    endif
 #endif
 }
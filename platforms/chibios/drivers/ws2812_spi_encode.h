@@ -0,0 +1,24 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+
+/*
+ * As the trick here is to use the SPI to send a huge pattern of 0 and 1 to
+ * the ws2812b protocol, each bit of color is sent as four SPI bits, 1110 for
+ * a one and 1000 for a zero. Every SPI byte so carries two bits of color,
+ * which this table translates directly.
+ */
+static const uint8_t ws2812_spi_bit_pairs[4] = {0b10001000, 0b10001110, 0b11101000, 0b11101110};
+
+/**
+ * @brief Encodes one byte of color into the four SPI bytes sending it, most significant bits first.
+ */
+static inline void ws2812_spi_encode_byte(uint8_t *dest, uint8_t data) {
+    dest[0] = ws2812_spi_bit_pairs[(data >> 6) & 0b11];
+    dest[1] = ws2812_spi_bit_pairs[(data >> 4) & 0b11];
+    dest[2] = ws2812_spi_bit_pairs[(data >> 2) & 0b11];
+    dest[3] = ws2812_spi_bit_pairs[data & 0b11];
+}
@@ -0,0 +1,53 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <ch.h>
+#include <hal.h>
+#include "gpio.h"
+#include "wakeup.h"
+
+#if !PAL_USE_CALLBACKS
+#    error "MATRIX_IDLE_WAIT_ENABLE requires PAL_USE_CALLBACKS to be set to TRUE in halconf.h"
+#endif
+
+static BSEMAPHORE_DECL(wakeup_sem, true);
+
+// Interrupt lines are selected by pad number only (e.g. STM32 EXTI), so A1 and B1 cannot both have one
+static ioportmask_t armed_pads;
+static pin_t        armed_pins[PAL_IOPORTS_WIDTH];
+
+static void wakeup_callback(void *arg) {
+    chSysLockFromISR();
+    chBSemSignalI(&wakeup_sem);
+    chSysUnlockFromISR();
+}
+
+bool gpio_enable_wakeup(pin_t pin) {
+    ioportmask_t pad_mask = PAL_PORT_BIT(PAL_PAD(pin));
+    if (armed_pads & pad_mask) {
+        return false;
+    }
+    armed_pads |= pad_mask;
+    armed_pins[PAL_PAD(pin)] = pin;
+
+    palEnableLineEvent(pin, PAL_EVENT_MODE_BOTH_EDGES);
+    palSetLineCallback(pin, wakeup_callback, NULL);
+    return true;
+}
+
+void gpio_disable_wakeup(pin_t pin) {
+    ioportmask_t pad_mask = PAL_PORT_BIT(PAL_PAD(pin));
+    // Leave the line alone if another pin owns it
+    if (!(armed_pads & pad_mask) || armed_pins[PAL_PAD(pin)] != pin) {
+        return;
+    }
+    armed_pads &= ~pad_mask;
+
+    palDisableLineEvent(pin);
+    // Drop any edge seen after the wait ended, so the next wait doesn't return early
+    chBSemReset(&wakeup_sem, true);
+}
+
+bool wakeup_wait(uint32_t timeout_ms) {
+    return chBSemWaitTimeout(&wakeup_sem, TIME_MS2I(timeout_ms)) == MSG_OK;
+}
@@ -0,0 +1,58 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+
+#include "i2c_master.h"
+#include "util.h"
+
+i2c_test_stats_t i2c_test_stats;
+
+__attribute__((weak)) void i2c_test_write_register_kb(uint8_t devaddr, uint16_t regaddr, const uint8_t* data, uint16_t length) {}
+
+static void i2c_test_count(uint16_t length) {
+    i2c_test_stats.transfers++;
+    i2c_test_stats.bytes += 1 + length;
+}
+
+void i2c_init(void) {}
+
+i2c_status_t i2c_transmit(uint8_t address, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_test_count(length);
+    return I2C_STATUS_SUCCESS;
+}
+
+i2c_status_t i2c_receive(uint8_t address, uint8_t* data, uint16_t length, uint16_t timeout) {
+    memset(data, 0, length);
+    i2c_test_count(length);
+    return I2C_STATUS_SUCCESS;
+}
+
+i2c_status_t i2c_write_register(uint8_t devaddr, uint8_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_test_count(1 + length);
+    i2c_test_write_register_kb(devaddr, regaddr, data, length);
+    return I2C_STATUS_SUCCESS;
+}
+
+i2c_status_t i2c_write_register16(uint8_t devaddr, uint16_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_test_count(2 + length);
+    i2c_test_write_register_kb(devaddr, regaddr, data, length);
+    return I2C_STATUS_SUCCESS;
+}
+
+i2c_status_t i2c_read_register(uint8_t devaddr, uint8_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout) {
+    memset(data, 0, length);
+    i2c_test_count(1 + length);
+    return I2C_STATUS_SUCCESS;
+}
+
+i2c_status_t i2c_read_register16(uint8_t devaddr, uint16_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout) {
+    memset(data, 0, length);
+    i2c_test_count(2 + length);
+    return I2C_STATUS_SUCCESS;
+}
+
+i2c_status_t i2c_ping_address(uint8_t address, uint16_t timeout) {
+    i2c_test_count(0);
+    return I2C_STATUS_SUCCESS;
+}
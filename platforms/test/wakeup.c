@@ -0,0 +1,38 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "timer.h"
+#include "wakeup.h"
+
+void advance_time(uint32_t ms);
+
+/* Simulated edge source: a single pending edge at a fixed point in time. */
+static bool     edge_pending = false;
+static uint32_t edge_time    = 0;
+
+void wakeup_simulate_edge(uint32_t time) {
+    edge_pending = true;
+    edge_time    = time;
+}
+
+void wakeup_clear_edge(void) {
+    edge_pending = false;
+}
+
+bool wakeup_wait(uint32_t timeout_ms) {
+    uint32_t now = timer_read32();
+
+    if (edge_pending) {
+        int32_t delta = (int32_t)TIMER_DIFF_32(edge_time, now);
+        if (delta <= (int32_t)timeout_ms) {
+            if (delta > 0) {
+                advance_time(delta);
+            }
+            edge_pending = false;
+            return true;
+        }
+    }
+
+    advance_time(timeout_ms);
+    return false;
+}
@@ -0,0 +1,63 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <cstdio>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "ws2812_spi_encode.h"
+}
+
+/* The bit by bit encoding ws2812_spi.c used before the table. */
+static uint8_t get_protocol_eq(uint8_t data, int pos) {
+    uint8_t eq = 0;
+    if (data & (1 << (2 * (3 - pos))))
+        eq = 0b1110;
+    else
+        eq = 0b1000;
+    if (data & (2 << (2 * (3 - pos))))
+        eq += 0b11100000;
+    else
+        eq += 0b10000000;
+    return eq;
+}
+
+TEST(Ws2812SpiEncode, MatchesBitByBitEncoding) {
+    for (int data = 0; data < 256; data++) {
+        uint8_t encoded[4];
+        ws2812_spi_encode_byte(encoded, data);
+        for (int pos = 0; pos < 4; pos++) {
+            EXPECT_EQ(encoded[pos], get_protocol_eq(data, pos)) << "byte " << data << ", position " << pos;
+        }
+    }
+}
+
+TEST(Ws2812SpiEncode, Benchmark) {
+    const int rounds = 10000;
+    uint8_t   encoded[256 * 4];
+    uint32_t  checksum = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+        for (int data = 0; data < 256; data++) {
+            for (int pos = 0; pos < 4; pos++) {
+                encoded[data * 4 + pos] = get_protocol_eq(data + r, pos);
+            }
+        }
+        checksum += encoded[r % sizeof(encoded)];
+    }
+    double bit_by_bit = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+        for (int data = 0; data < 256; data++) {
+            ws2812_spi_encode_byte(&encoded[data * 4], data + r);
+        }
+        checksum += encoded[r % sizeof(encoded)];
+    }
+    double table = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    printf("bit by bit: %.2f ns per byte, table: %.2f ns per byte (%u)\n", bit_by_bit * 1e9 / (rounds * 256), table * 1e9 / (rounds * 256), checksum);
+}
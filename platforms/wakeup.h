@@ -0,0 +1,15 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * Blocks until one of the pins armed with gpio_enable_wakeup() sees an edge, or until `timeout_ms` elapses.
+ *
+ * @param timeout_ms[in] the maximum number of milliseconds to block for
+ * @return true if woken by an edge, false on timeout
+ */
+bool wakeup_wait(uint32_t timeout_ms);
@@ -64,6 +64,7 @@ action_t action_for_keycode(uint16_t keycode);
 
 /* keyboard-specific key event (pre)processing */
 bool process_record_quantum(keyrecord_t *record);
+void process_record_routes_init(void);
 
 /* Utilities for actions.  */
 #if !defined(NO_ACTION_LAYER) && !defined(STRICT_LAYER_RELEASE)
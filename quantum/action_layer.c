@@ -1,5 +1,6 @@
 #include <limits.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "keyboard.h"
 #include "action.h"
@@ -316,16 +317,15 @@ action_t store_or_get_action(bool pressed, keypos_t key) {
 #endif
 }
 
-/** \brief Layer switch get layer
+#ifndef NO_ACTION_LAYER
+/** \brief Resolve layer
  *
- * Gets the layer based on key info
+ * Walks the active layers from the top down to the first non-transparent action for the key
  */
-uint8_t layer_switch_get_layer(keypos_t key) {
-#ifndef NO_ACTION_LAYER
+static uint8_t resolve_layer(layer_state_t layers, keypos_t key) {
     action_t action;
     action.code = ACTION_TRANSPARENT;
 
-    layer_state_t layers = layer_state | default_layer_state;
     /* check top layer first */
     for (int8_t i = MAX_LAYER - 1; i >= 0; i--) {
         if (layers & ((layer_state_t)1 << i)) {
@@ -337,6 +337,51 @@ uint8_t layer_switch_get_layer(keypos_t key) {
     }
     /* fall back to layer 0 */
     return 0;
+}
+#endif
+
+#if defined(LAYER_CACHE_ENABLE) && !defined(NO_ACTION_LAYER)
+/** \brief resolved layer cache
+ *
+ * The layer each matrix position resolved to under layer_cache_state, LAYER_CACHE_EMPTY if not resolved yet.
+ * A change of layer_state or default_layer_state, however it was made, empties the cache on the next lookup.
+ */
+#    define LAYER_CACHE_EMPTY UINT8_MAX
+static uint8_t       layer_cache[MATRIX_ROWS][MATRIX_COLS];
+static layer_state_t layer_cache_state = 0;
+static bool          layer_cache_valid = false;
+
+/** \brief Layer cache invalidate
+ *
+ * Must be called whenever the keycodes returned by keymap_key_to_keycode() change
+ */
+void layer_cache_invalidate(void) {
+    layer_cache_valid = false;
+}
+#endif
+
+/** \brief Layer switch get layer
+ *
+ * Gets the layer based on key info
+ */
+uint8_t layer_switch_get_layer(keypos_t key) {
+#ifndef NO_ACTION_LAYER
+    layer_state_t layers = layer_state | default_layer_state;
+#    ifdef LAYER_CACHE_ENABLE
+    if (key.row < MATRIX_ROWS && key.col < MATRIX_COLS) {
+        if (!layer_cache_valid || layer_cache_state != layers) {
+            memset(layer_cache, LAYER_CACHE_EMPTY, sizeof(layer_cache));
+            layer_cache_state = layers;
+            layer_cache_valid = true;
+        }
+        uint8_t *entry = &layer_cache[key.row][key.col];
+        if (*entry == LAYER_CACHE_EMPTY) {
+            *entry = resolve_layer(layers, key);
+        }
+        return *entry;
+    }
+#    endif
+    return resolve_layer(layers, key);
 #else
     return get_highest_layer(default_layer_state);
 #endif
@@ -19,6 +19,70 @@
 #include "progmem.h"
 #include "util.h"
 
+#ifdef USE_HSV_LOOKUP_TABLES
+// clang-format off
+// The region of the hue wheel each hue falls in, h * 6 / 255
+static const uint8_t HSV_HUE_REGION[256] PROGMEM = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 4, 4, 4, 4, 4, 4,
+    4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+    4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+    4, 4, 4, 4, 4, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 6,
+};
+// clang-format on
+#endif
+
+static inline RGB hsv_region_to_rgb(uint8_t region, uint8_t v, uint8_t p, uint8_t q, uint8_t t) {
+    RGB rgb;
+
+    switch (region) {
+        case 6:
+        case 0:
+            rgb.r = v;
+            rgb.g = t;
+            rgb.b = p;
+            break;
+        case 1:
+            rgb.r = q;
+            rgb.g = v;
+            rgb.b = p;
+            break;
+        case 2:
+            rgb.r = p;
+            rgb.g = v;
+            rgb.b = t;
+            break;
+        case 3:
+            rgb.r = p;
+            rgb.g = q;
+            rgb.b = v;
+            break;
+        case 4:
+            rgb.r = t;
+            rgb.g = p;
+            rgb.b = v;
+            break;
+        default:
+            rgb.r = v;
+            rgb.g = p;
+            rgb.b = q;
+            break;
+    }
+
+    return rgb;
+}
+
 RGB hsv_to_rgb_impl(HSV hsv, bool use_cie) {
     RGB      rgb;
     uint8_t  region, remainder, p, q, t;
@@ -53,48 +117,18 @@ RGB hsv_to_rgb_impl(HSV hsv, bool use_cie) {
     v = hsv.v;
 #endif
 
-    region    = h * 6 / 255;
+#ifdef USE_HSV_LOOKUP_TABLES
+    region = pgm_read_byte(&HSV_HUE_REGION[h]);
+#else
+    region = h * 6 / 255;
+#endif
     remainder = (h * 2 - region * 85) * 3;
 
     p = (v * (255 - s)) >> 8;
     q = (v * (255 - ((s * remainder) >> 8))) >> 8;
     t = (v * (255 - ((s * (255 - remainder)) >> 8))) >> 8;
 
-    switch (region) {
-        case 6:
-        case 0:
-            rgb.r = v;
-            rgb.g = t;
-            rgb.b = p;
-            break;
-        case 1:
-            rgb.r = q;
-            rgb.g = v;
-            rgb.b = p;
-            break;
-        case 2:
-            rgb.r = p;
-            rgb.g = v;
-            rgb.b = t;
-            break;
-        case 3:
-            rgb.r = p;
-            rgb.g = q;
-            rgb.b = v;
-            break;
-        case 4:
-            rgb.r = t;
-            rgb.g = p;
-            rgb.b = v;
-            break;
-        default:
-            rgb.r = v;
-            rgb.g = p;
-            rgb.b = q;
-            break;
-    }
-
-    return rgb;
+    return hsv_region_to_rgb(region, v, p, q, t);
 }
 
 RGB hsv_to_rgb(HSV hsv) {
@@ -109,6 +143,55 @@ RGB hsv_to_rgb_nocie(HSV hsv) {
     return hsv_to_rgb_impl(hsv, false);
 }
 
+#ifdef USE_HSV_LOOKUP_TABLES
+// Runs of colors sharing saturation and value shorter than this are converted one by one,
+// longer ones from a table of their q and t components built for the run.
+#    define HSV_BATCH_MIN_RUN 32
+
+void hsv_to_rgb_batch(const HSV *hsv, RGB *rgb, uint16_t count) {
+    // q or t for each remainder, which are multiples of 3, at the saturation and value of the run
+    uint8_t scale[86];
+
+    for (uint16_t i = 0; i < count;) {
+        uint16_t end = i + 1;
+        while (end < count && hsv[end].s == hsv[i].s && hsv[end].v == hsv[i].v) {
+            end++;
+        }
+
+        if (end - i < HSV_BATCH_MIN_RUN || hsv[i].s == 0) {
+            for (; i < end; i++) {
+                rgb[i] = hsv_to_rgb(hsv[i]);
+            }
+            continue;
+        }
+
+        uint16_t s = hsv[i].s;
+#    ifdef USE_CIE1931_CURVE
+        uint16_t v = pgm_read_byte(&CIE1931_CURVE[hsv[i].v]);
+#    else
+        uint16_t v = hsv[i].v;
+#    endif
+
+        uint8_t p = (v * (255 - s)) >> 8;
+        for (uint8_t k = 0; k < ARRAY_SIZE(scale); k++) {
+            scale[k] = (v * (255 - ((s * (k * 3)) >> 8))) >> 8;
+        }
+
+        for (; i < end; i++) {
+            uint8_t region = pgm_read_byte(&HSV_HUE_REGION[hsv[i].h]);
+            uint8_t k      = hsv[i].h * 2 - region * 85;
+            rgb[i]         = hsv_region_to_rgb(region, v, p, scale[k], scale[85 - k]);
+        }
+    }
+}
+#else
+void hsv_to_rgb_batch(const HSV *hsv, RGB *rgb, uint16_t count) {
+    for (uint16_t i = 0; i < count; i++) {
+        rgb[i] = hsv_to_rgb(hsv[i]);
+    }
+}
+#endif
+
 #ifdef WS2812_RGBW
 void convert_rgb_to_rgbw(rgb_led_t *led) {
     // Determine lowest value in all three colors, put that into
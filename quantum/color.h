@@ -111,6 +111,10 @@ typedef struct PACKED HSV {
 
 RGB hsv_to_rgb(HSV hsv);
 RGB hsv_to_rgb_nocie(HSV hsv);
+/**
+ * @brief Converts `count` colors at once, the same as calling hsv_to_rgb() on each of them.
+ */
+void hsv_to_rgb_batch(const HSV *hsv, RGB *rgb, uint16_t count);
 #ifdef WS2812_RGBW
 void convert_rgb_to_rgbw(rgb_led_t *led);
 #endif
@@ -0,0 +1,172 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+Bit-sliced symmetric per-key algorithm. Behaves exactly like sym_defer_pk,
+but the per-key counters are stored as bit planes, one matrix_row_t per
+counter bit per row. Bit n of plane k holds bit k of the counter for column n,
+so a whole row is counted down with a handful of bitwise operations no matter
+how many columns it has, and no heap allocation is required.
+When no state changes have occured for DEBOUNCE milliseconds, we push the state.
+*/
+
+#include "debounce.h"
+#include "timer.h"
+
+#ifndef DEBOUNCE
+#    define DEBOUNCE 5
+#endif
+
+// Maximum debounce: 255ms
+#if DEBOUNCE > UINT8_MAX
+#    undef DEBOUNCE
+#    define DEBOUNCE UINT8_MAX
+#endif
+
+#if DEBOUNCE > 0
+
+// Number of bit planes needed to hold a counter of value DEBOUNCE
+#    if DEBOUNCE < 2
+#        define DEBOUNCE_BITS 1
+#    elif DEBOUNCE < 4
+#        define DEBOUNCE_BITS 2
+#    elif DEBOUNCE < 8
+#        define DEBOUNCE_BITS 3
+#    elif DEBOUNCE < 16
+#        define DEBOUNCE_BITS 4
+#    elif DEBOUNCE < 32
+#        define DEBOUNCE_BITS 5
+#    elif DEBOUNCE < 64
+#        define DEBOUNCE_BITS 6
+#    elif DEBOUNCE < 128
+#        define DEBOUNCE_BITS 7
+#    else
+#        define DEBOUNCE_BITS 8
+#    endif
+
+static matrix_row_t debounce_planes[MATRIX_ROWS][DEBOUNCE_BITS];
+static fast_timer_t last_time;
+static bool         counters_need_update;
+static bool         cooked_changed;
+
+static void update_debounce_counters_and_transfer_if_expired(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, uint8_t elapsed_time);
+static void start_debounce_counters(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows);
+
+// we use num_rows rather than MATRIX_ROWS to support split keyboards
+void debounce_init(uint8_t num_rows) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t bit = 0; bit < DEBOUNCE_BITS; bit++) {
+            debounce_planes[row][bit] = 0;
+        }
+    }
+    counters_need_update = false;
+}
+
+void debounce_free(void) {}
+
+bool debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed) {
+    bool updated_last = false;
+    cooked_changed    = false;
+
+    if (counters_need_update) {
+        fast_timer_t now          = timer_read_fast();
+        fast_timer_t elapsed_time = TIMER_DIFF_FAST(now, last_time);
+
+        last_time    = now;
+        updated_last = true;
+        // No counter ever exceeds DEBOUNCE, so this keeps the subtrahend
+        // within DEBOUNCE_BITS without changing which counters expire.
+        if (elapsed_time > DEBOUNCE) {
+            elapsed_time = DEBOUNCE;
+        }
+
+        if (elapsed_time > 0) {
+            update_debounce_counters_and_transfer_if_expired(raw, cooked, num_rows, elapsed_time);
+        }
+    }
+
+    if (changed) {
+        if (!updated_last) {
+            last_time = timer_read_fast();
+        }
+
+        start_debounce_counters(raw, cooked, num_rows);
+    }
+
+    return cooked_changed;
+}
+
+static void update_debounce_counters_and_transfer_if_expired(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, uint8_t elapsed_time) {
+    counters_need_update = false;
+    for (uint8_t row = 0; row < num_rows; row++) {
+        matrix_row_t *planes = debounce_planes[row];
+        matrix_row_t  active = 0;
+        for (uint8_t bit = 0; bit < DEBOUNCE_BITS; bit++) {
+            active |= planes[bit];
+        }
+        if (!active) {
+            continue;
+        }
+
+        // Ripple-borrow subtraction of elapsed_time from every counter in the row
+        matrix_row_t borrow  = 0;
+        matrix_row_t nonzero = 0;
+        for (uint8_t bit = 0; bit < DEBOUNCE_BITS; bit++) {
+            matrix_row_t a = planes[bit];
+            matrix_row_t d;
+            if (elapsed_time & (1 << bit)) {
+                d      = ~(a ^ borrow);
+                borrow = ~a | borrow;
+            } else {
+                d      = a ^ borrow;
+                borrow = ~a & borrow;
+            }
+            planes[bit] = d;
+            nonzero |= d;
+        }
+
+        // A counter expires when it would reach zero or go below it
+        matrix_row_t expired = active & (borrow | ~nonzero);
+        matrix_row_t keep    = active & ~expired;
+        for (uint8_t bit = 0; bit < DEBOUNCE_BITS; bit++) {
+            planes[bit] &= keep;
+        }
+        if (keep) {
+            counters_need_update = true;
+        }
+
+        if (expired) {
+            matrix_row_t cooked_next = (cooked[row] & ~expired) | (raw[row] & expired);
+            cooked_changed |= cooked[row] ^ cooked_next;
+            cooked[row] = cooked_next;
+        }
+    }
+}
+
+static void start_debounce_counters(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows) {
+    for (uint8_t row = 0; row < num_rows; row++) {
+        matrix_row_t *planes = debounce_planes[row];
+        matrix_row_t  delta  = raw[row] ^ cooked[row];
+        matrix_row_t  active = 0;
+        for (uint8_t bit = 0; bit < DEBOUNCE_BITS; bit++) {
+            active |= planes[bit];
+        }
+
+        // Keys that changed and are not already counting start at DEBOUNCE,
+        // keys that have not changed are reset
+        matrix_row_t start = delta & ~active;
+        for (uint8_t bit = 0; bit < DEBOUNCE_BITS; bit++) {
+            if (DEBOUNCE & (1 << bit)) {
+                planes[bit] |= start;
+            }
+            planes[bit] &= delta;
+        }
+        if (start) {
+            counters_need_update = true;
+        }
+    }
+}
+
+#else
+#    include "none.c"
+#endif
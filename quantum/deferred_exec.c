@@ -115,6 +115,26 @@ bool cancel_deferred_exec_advanced(deferred_executor_t *table, size_t table_coun
     return false;
 }
 
+uint32_t deferred_exec_advanced_time_until_next(deferred_executor_t *table, size_t table_count) {
+    uint32_t now       = timer_read32();
+    uint32_t time_left = UINT32_MAX;
+
+    for (int i = 0; i < table_count; ++i) {
+        deferred_executor_t *entry = &table[i];
+        if (entry->token != INVALID_DEFERRED_TOKEN) {
+            int32_t delta = (int32_t)TIMER_DIFF_32(entry->trigger_time, now);
+            if (delta <= 0) {
+                return 0;
+            }
+            if ((uint32_t)delta < time_left) {
+                time_left = delta;
+            }
+        }
+    }
+
+    return time_left;
+}
+
 void deferred_exec_advanced_task(deferred_executor_t *table, size_t table_count, uint32_t *last_execution_time) {
     uint32_t now = timer_read32();
 
@@ -172,6 +192,9 @@ bool extend_deferred_exec(deferred_token token, uint32_t delay_ms) {
 bool cancel_deferred_exec(deferred_token token) {
     return cancel_deferred_exec_advanced(basic_executors, MAX_DEFERRED_EXECUTORS, token);
 }
+uint32_t deferred_exec_time_until_next(void) {
+    return deferred_exec_advanced_time_until_next(basic_executors, MAX_DEFERRED_EXECUTORS);
+}
 void deferred_exec_task(void) {
     deferred_exec_advanced_task(basic_executors, MAX_DEFERRED_EXECUTORS, &last_deferred_exec_check);
 }
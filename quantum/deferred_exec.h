@@ -60,6 +60,13 @@ bool extend_deferred_exec(deferred_token token, uint32_t delay_ms);
  */
 bool cancel_deferred_exec(deferred_token token);
 
+/**
+ * Determines how long until the next deferred execution is due.
+ *
+ * @return the number of milliseconds until the earliest executor triggers, 0 if one is already due, or UINT32_MAX if none are queued
+ */
+uint32_t deferred_exec_time_until_next(void);
+
 /**
  * Forward declaration for the main loop in order to execute any deferred executors. Should not be invoked by keyboard/user code.
  */
@@ -110,6 +117,15 @@ bool extend_deferred_exec_advanced(deferred_executor_t *table, size_t table_coun
  */
 bool cancel_deferred_exec_advanced(deferred_executor_t *table, size_t table_count, deferred_token token);
 
+/**
+ * Determines how long until the next deferred execution in the custom table is due.
+ *
+ * @param table[in] the custom table used for storage
+ * @param table_count[in] the number of available items in the table
+ * @return the number of milliseconds until the earliest executor triggers, 0 if one is already due, or UINT32_MAX if none are queued
+ */
+uint32_t deferred_exec_advanced_time_until_next(deferred_executor_t *table, size_t table_count);
+
 /**
  * Forward declaration for the main loop in order to execute any custom table deferred executors. Should not be invoked by keyboard/user code.
  * Needed for any custom-allocated deferred execution tables. Any core tasks should add appropriate invocation to quantum/main.c.
@@ -17,10 +17,12 @@
 #include "dynamic_keymap.h"
 #include "keymap_introspection.h"
 #include "action.h"
+#include "action_layer.h"
 #include "eeprom.h"
 #include "progmem.h"
 #include "send_string.h"
 #include "keycodes.h"
+#include "timer.h"
 
 #ifdef VIA_ENABLE
 #    include "via.h"
@@ -110,21 +112,127 @@ void *dynamic_keymap_key_to_eeprom_address(uint8_t layer, uint8_t row, uint8_t c
     return ((void *)DYNAMIC_KEYMAP_EEPROM_ADDR) + (layer * MATRIX_ROWS * MATRIX_COLS * 2) + (row * MATRIX_COLS * 2) + (column * 2);
 }
 
+#ifdef DYNAMIC_KEYMAP_RAM_SHADOW
+#    ifndef DYNAMIC_KEYMAP_FLUSH_DELAY
+#        define DYNAMIC_KEYMAP_FLUSH_DELAY 500
+#    endif
+
+// Each key written back costs up to two EEPROM byte writes, about 3.4ms each
+// on AVR, during which the main loop does not scan the matrix
+#    ifndef DYNAMIC_KEYMAP_FLUSH_BATCH
+#        if defined(__AVR__)
+#            define DYNAMIC_KEYMAP_FLUSH_BATCH 1
+#        else
+#            define DYNAMIC_KEYMAP_FLUSH_BATCH 8
+#        endif
+#    endif
+
+#    define DYNAMIC_KEYMAP_KEY_COUNT (DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS)
+
+// RAM copy of the keymap, in the same order as the EEPROM buffer. Keys that
+// differ from EEPROM are flagged dirty, and written back once no further
+// change has been made for DYNAMIC_KEYMAP_FLUSH_DELAY milliseconds.
+static uint16_t keymap_shadow[DYNAMIC_KEYMAP_KEY_COUNT];
+static uint8_t  keymap_dirty[(DYNAMIC_KEYMAP_KEY_COUNT + 7) / 8];
+static uint16_t keymap_dirty_count   = 0;
+static uint16_t keymap_flush_cursor  = 0;
+static uint32_t keymap_last_write    = 0;
+static bool     keymap_shadow_loaded = false;
+
+static void keymap_shadow_load(void) {
+    const uint8_t *address = (const uint8_t *)DYNAMIC_KEYMAP_EEPROM_ADDR;
+    for (uint16_t i = 0; i < DYNAMIC_KEYMAP_KEY_COUNT; i++) {
+        // Big endian, as stored in EEPROM
+        keymap_shadow[i] = eeprom_read_byte(address) << 8;
+        keymap_shadow[i] |= eeprom_read_byte(address + 1);
+        address += 2;
+    }
+    keymap_shadow_loaded = true;
+}
+
+static inline uint16_t *keymap_shadow_entry(uint16_t index) {
+    if (!keymap_shadow_loaded) {
+        keymap_shadow_load();
+    }
+    return &keymap_shadow[index];
+}
+
+static void keymap_shadow_mark_dirty(uint16_t index) {
+    if (!(keymap_dirty[index / 8] & (1 << (index % 8)))) {
+        keymap_dirty[index / 8] |= 1 << (index % 8);
+        keymap_dirty_count++;
+    }
+    keymap_last_write = timer_read32();
+}
+
+static void keymap_shadow_write_back(uint16_t index) {
+    void *address = ((void *)DYNAMIC_KEYMAP_EEPROM_ADDR) + (index * 2);
+    eeprom_update_byte(address, (uint8_t)(keymap_shadow[index] >> 8));
+    eeprom_update_byte(address + 1, (uint8_t)(keymap_shadow[index] & 0xFF));
+    keymap_dirty[index / 8] &= ~(1 << (index % 8));
+    keymap_dirty_count--;
+}
+
+static inline uint16_t keymap_shadow_index(uint8_t layer, uint8_t row, uint8_t column) {
+    return (layer * MATRIX_ROWS * MATRIX_COLS) + (row * MATRIX_COLS) + column;
+}
+
+void dynamic_keymap_flush(void) {
+    for (uint16_t index = 0; keymap_dirty_count > 0 && index < DYNAMIC_KEYMAP_KEY_COUNT; index++) {
+        if (keymap_dirty[index / 8] & (1 << (index % 8))) {
+            keymap_shadow_write_back(index);
+        }
+    }
+}
+
+void dynamic_keymap_task(void) {
+    if (keymap_dirty_count == 0 || timer_elapsed32(keymap_last_write) < DYNAMIC_KEYMAP_FLUSH_DELAY) {
+        return;
+    }
+
+    // Write back a bounded number of keys per call, picking up where the last call stopped
+    for (uint16_t scanned = 0, written = 0; keymap_dirty_count > 0 && written < DYNAMIC_KEYMAP_FLUSH_BATCH && scanned < DYNAMIC_KEYMAP_KEY_COUNT; scanned++) {
+        uint16_t index = keymap_flush_cursor;
+        if (++keymap_flush_cursor >= DYNAMIC_KEYMAP_KEY_COUNT) {
+            keymap_flush_cursor = 0;
+        }
+        if (keymap_dirty[index / 8] & (1 << (index % 8))) {
+            keymap_shadow_write_back(index);
+            written++;
+        }
+    }
+}
+#endif // DYNAMIC_KEYMAP_RAM_SHADOW
+
 uint16_t dynamic_keymap_get_keycode(uint8_t layer, uint8_t row, uint8_t column) {
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return KC_NO;
+#ifdef DYNAMIC_KEYMAP_RAM_SHADOW
+    return *keymap_shadow_entry(keymap_shadow_index(layer, row, column));
+#else
     void *address = dynamic_keymap_key_to_eeprom_address(layer, row, column);
     // Big endian, so we can read/write EEPROM directly from host if we want
     uint16_t keycode = eeprom_read_byte(address) << 8;
     keycode |= eeprom_read_byte(address + 1);
     return keycode;
+#endif
 }
 
 void dynamic_keymap_set_keycode(uint8_t layer, uint8_t row, uint8_t column, uint16_t keycode) {
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return;
+#ifdef DYNAMIC_KEYMAP_RAM_SHADOW
+    uint16_t  index = keymap_shadow_index(layer, row, column);
+    uint16_t *entry = keymap_shadow_entry(index);
+    if (*entry != keycode) {
+        *entry = keycode;
+        keymap_shadow_mark_dirty(index);
+    }
+#else
     void *address = dynamic_keymap_key_to_eeprom_address(layer, row, column);
     // Big endian, so we can read/write EEPROM directly from host if we want
     eeprom_update_byte(address, (uint8_t)(keycode >> 8));
     eeprom_update_byte(address + 1, (uint8_t)(keycode & 0xFF));
+#endif
+    layer_cache_invalidate();
 }
 
 #ifdef ENCODER_MAP_ENABLE
@@ -165,15 +273,27 @@ void dynamic_keymap_reset(void) {
         }
 #endif // ENCODER_MAP_ENABLE
     }
+#ifdef DYNAMIC_KEYMAP_RAM_SHADOW
+    // The EEPROM may just have been formatted underneath the shadow, so persist everything right away
+    for (uint16_t index = 0; index < DYNAMIC_KEYMAP_KEY_COUNT; index++) {
+        keymap_shadow_mark_dirty(index);
+    }
+    dynamic_keymap_flush();
+#endif
 }
 
 void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
     uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
-    void *   source                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
+    void *   source                     = (void *)(uintptr_t)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
     uint8_t *target                     = data;
     for (uint16_t i = 0; i < size; i++) {
         if (offset + i < dynamic_keymap_eeprom_size) {
+#ifdef DYNAMIC_KEYMAP_RAM_SHADOW
+            uint16_t keycode = *keymap_shadow_entry((offset + i) / 2);
+            *target          = ((offset + i) % 2) ? (uint8_t)(keycode & 0xFF) : (uint8_t)(keycode >> 8);
+#else
             *target = eeprom_read_byte(source);
+#endif
         } else {
             *target = 0x00;
         }
@@ -184,15 +304,26 @@ void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
 
 void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
     uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
-    void *   target                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
+    void *   target                     = (void *)(uintptr_t)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
     uint8_t *source                     = data;
     for (uint16_t i = 0; i < size; i++) {
         if (offset + i < dynamic_keymap_eeprom_size) {
+#ifdef DYNAMIC_KEYMAP_RAM_SHADOW
+            uint16_t  index   = (offset + i) / 2;
+            uint16_t *entry   = keymap_shadow_entry(index);
+            uint16_t  keycode = ((offset + i) % 2) ? ((*entry & 0xFF00) | *source) : ((*entry & 0x00FF) | (*source << 8));
+            if (*entry != keycode) {
+                *entry = keycode;
+                keymap_shadow_mark_dirty(index);
+            }
+#else
             eeprom_update_byte(target, *source);
+#endif
         }
         source++;
         target++;
     }
+    layer_cache_invalidate();
 }
 
 uint16_t keycode_at_keymap_location(uint8_t layer_num, uint8_t row, uint8_t column) {
@@ -220,7 +351,7 @@ uint16_t dynamic_keymap_macro_get_buffer_size(void) {
 }
 
 void dynamic_keymap_macro_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    void *   source = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
+    void *   source = (void *)(uintptr_t)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
     uint8_t *target = data;
     for (uint16_t i = 0; i < size; i++) {
         if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
@@ -234,7 +365,7 @@ void dynamic_keymap_macro_get_buffer(uint16_t offset, uint16_t size, uint8_t *da
 }
 
 void dynamic_keymap_macro_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    void *   target = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
+    void *   target = (void *)(uintptr_t)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
     uint8_t *source = data;
     for (uint16_t i = 0; i < size; i++) {
         if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
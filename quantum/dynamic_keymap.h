@@ -38,6 +38,14 @@ void dynamic_keymap_reset(void);
 void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data);
 void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data);
 
+#ifdef DYNAMIC_KEYMAP_RAM_SHADOW
+// With DYNAMIC_KEYMAP_RAM_SHADOW, keycodes are read from and written to a RAM
+// copy of the keymap. Changes are written back to EEPROM in the background by
+// dynamic_keymap_task(), or immediately by dynamic_keymap_flush().
+void dynamic_keymap_task(void);
+void dynamic_keymap_flush(void);
+#endif
+
 // This overrides the one in quantum/keymap_common.c
 // uint16_t keymap_key_to_keycode(uint8_t layer, keypos_t key);
 
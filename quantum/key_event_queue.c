@@ -0,0 +1,60 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "key_event_queue.h"
+
+#define KEY_EVENT_QUEUE_MASK (KEY_EVENT_QUEUE_SIZE - 1)
+
+static keyevent_t queue[KEY_EVENT_QUEUE_SIZE];
+// Free running indices, each written by one side only
+static uint8_t queue_head = 0;
+static uint8_t queue_tail = 0;
+// Statistics, written by the producer only
+static volatile uint16_t queue_overflows  = 0;
+static volatile uint8_t  queue_high_water = 0;
+
+bool key_event_queue_push(keyevent_t event) {
+    uint8_t head  = queue_head;
+    uint8_t tail  = __atomic_load_n(&queue_tail, __ATOMIC_ACQUIRE);
+    uint8_t count = (uint8_t)(head - tail);
+
+    if (count >= KEY_EVENT_QUEUE_SIZE) {
+        queue_overflows++;
+        return false;
+    }
+
+    queue[head & KEY_EVENT_QUEUE_MASK] = event;
+    // Publish the event before the index that makes it visible
+    __atomic_store_n(&queue_head, (uint8_t)(head + 1), __ATOMIC_RELEASE);
+
+    if (count + 1 > queue_high_water) {
+        queue_high_water = count + 1;
+    }
+    return true;
+}
+
+bool key_event_queue_pop(keyevent_t *event) {
+    uint8_t tail = queue_tail;
+    uint8_t head = __atomic_load_n(&queue_head, __ATOMIC_ACQUIRE);
+
+    if (head == tail) {
+        return false;
+    }
+
+    *event = queue[tail & KEY_EVENT_QUEUE_MASK];
+    // Only hand the slot back to the producer once the event has been copied out
+    __atomic_store_n(&queue_tail, (uint8_t)(tail + 1), __ATOMIC_RELEASE);
+    return true;
+}
+
+uint8_t key_event_queue_count(void) {
+    return (uint8_t)(__atomic_load_n(&queue_head, __ATOMIC_ACQUIRE) - __atomic_load_n(&queue_tail, __ATOMIC_ACQUIRE));
+}
+
+uint16_t key_event_queue_overflows(void) {
+    return queue_overflows;
+}
+
+uint8_t key_event_queue_high_water(void) {
+    return queue_high_water;
+}
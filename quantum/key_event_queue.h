@@ -0,0 +1,69 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "keyboard.h"
+
+/*
+    Single-producer/single-consumer queue of timestamped key events between
+    the matrix scan and action processing.
+
+    The scan pushes every key change it sees, the main loop pops them and
+    runs them through action_exec(). Neither side ever blocks or disables
+    interrupts: the producer only writes the head index and the consumer only
+    writes the tail index, each published with release semantics, so the scan
+    can run from a timer interrupt or a separate thread.
+
+    When the queue is full the push fails and the change is counted as an
+    overflow; the matrix scan then leaves the key unacknowledged and retries
+    it on its next pass, so transitions are delayed but never lost.
+*/
+
+#ifndef KEY_EVENT_QUEUE_SIZE
+#    define KEY_EVENT_QUEUE_SIZE 32
+#endif
+
+#if (KEY_EVENT_QUEUE_SIZE & (KEY_EVENT_QUEUE_SIZE - 1)) != 0 || KEY_EVENT_QUEUE_SIZE > 128
+#    error KEY_EVENT_QUEUE_SIZE must be a power of two, at most 128
+#endif
+
+/**
+ * @brief Queues an event. Must only be called from the producer side.
+ *
+ * @return false if the queue was full and the event was dropped
+ */
+bool key_event_queue_push(keyevent_t event);
+
+/**
+ * @brief Takes the oldest event off the queue. Must only be called from the consumer side.
+ *
+ * @return false if the queue was empty
+ */
+bool key_event_queue_pop(keyevent_t *event);
+
+/**
+ * @brief Returns the number of queued events.
+ */
+uint8_t key_event_queue_count(void);
+
+/**
+ * @brief Returns the number of events that could not be queued because the queue was full.
+ */
+uint16_t key_event_queue_overflows(void);
+
+/**
+ * @brief Returns the highest number of events that were queued at once.
+ */
+uint8_t key_event_queue_high_water(void);
+
+/**
+ * @brief Scans the matrix and queues its changes. Called from keyboard_task()
+ * unless KEY_EVENT_QUEUE_ASYNC_SCAN is defined, in which case the keyboard
+ * calls it from its own timer interrupt or thread.
+ *
+ * @return true if the matrix changed
+ */
+bool keyboard_scan_task(void);
@@ -32,6 +32,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "sendchar.h"
 #include "eeconfig.h"
 #include "action_layer.h"
+#include "task_profiler.h"
+#ifdef TASK_SCHEDULER_ENABLE
+#    include "task_scheduler.h"
+#endif
 #ifdef BOOTMAGIC_ENABLE
 #    include "bootmagic.h"
 #endif
@@ -140,6 +144,33 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef OS_DETECTION_ENABLE
 #    include "os_detection.h"
 #endif
+#ifdef DYNAMIC_KEYMAP_ENABLE
+#    include "dynamic_keymap.h"
+#endif
+#ifdef KEY_EVENT_QUEUE_ENABLE
+#    include "key_event_queue.h"
+#endif
+#if defined(KEY_EVENT_QUEUE_ASYNC_SCAN) && defined(SPLIT_KEYBOARD)
+#    error "KEY_EVENT_QUEUE_ASYNC_SCAN is not supported on split keyboards"
+#endif
+#ifdef DEFERRED_EXEC_ENABLE
+#    include "deferred_exec.h"
+#endif
+#ifdef SEND_STRING_ASYNC_ENABLE
+#    include "send_string.h"
+#endif
+
+#ifdef MATRIX_IDLE_WAIT_ENABLE
+#    ifdef SPLIT_KEYBOARD
+#        error "MATRIX_IDLE_WAIT_ENABLE is not supported on split keyboards"
+#    endif
+#    ifndef MATRIX_IDLE_WAIT_TIMEOUT
+#        define MATRIX_IDLE_WAIT_TIMEOUT 1000
+#    endif
+#    ifndef MATRIX_IDLE_WAIT_MAX
+#        define MATRIX_IDLE_WAIT_MAX 100
+#    endif
+#endif
 
 static uint32_t last_input_modification_time = 0;
 uint32_t        last_input_activity_time(void) {
@@ -401,6 +432,131 @@ void quantum_init(void) {
     layer_state_set_kb((layer_state_t)layer_state);
 }
 
+#ifdef TASK_SCHEDULER_ENABLE
+// Background tasks of keyboard_task(), run by the scheduler once input has been serviced
+#    define SCHEDULED_TASK(name, profiler_task, ...)  \
+        static bool name##_scheduled_task(void) {     \
+            TASK_PROFILE(profiler_task, __VA_ARGS__); \
+            return false;                             \
+        }
+
+#    if defined(SPLIT_WATCHDOG_ENABLE)
+SCHEDULED_TASK(split_watchdog, TASK_PROFILER_SPLIT_WATCHDOG, split_watchdog_task())
+#    endif
+#    if defined(RGBLIGHT_ENABLE)
+SCHEDULED_TASK(rgblight, TASK_PROFILER_RGBLIGHT, rgblight_task())
+#    endif
+#    ifdef LED_MATRIX_ENABLE
+SCHEDULED_TASK(led_matrix, TASK_PROFILER_LED_MATRIX, led_matrix_task())
+#    endif
+#    ifdef RGB_MATRIX_ENABLE
+SCHEDULED_TASK(rgb_matrix, TASK_PROFILER_RGB_MATRIX, rgb_matrix_task())
+#    endif
+#    if defined(BACKLIGHT_ENABLE) && (defined(BACKLIGHT_PIN) || defined(BACKLIGHT_PINS))
+SCHEDULED_TASK(backlight, TASK_PROFILER_BACKLIGHT, backlight_task())
+#    endif
+#    ifdef OLED_ENABLE
+SCHEDULED_TASK(oled, TASK_PROFILER_OLED, oled_task())
+#    endif
+#    ifdef ST7565_ENABLE
+SCHEDULED_TASK(st7565, TASK_PROFILER_ST7565, st7565_task())
+#    endif
+#    ifdef QUANTUM_PAINTER_ENABLE
+void qp_internal_task(void);
+SCHEDULED_TASK(quantum_painter, TASK_PROFILER_QUANTUM_PAINTER, qp_internal_task())
+#    endif
+#    ifdef MOUSEKEY_ENABLE
+SCHEDULED_TASK(mousekey, TASK_PROFILER_MOUSEKEY, mousekey_task())
+#    endif
+#    ifdef PS2_MOUSE_ENABLE
+SCHEDULED_TASK(ps2_mouse, TASK_PROFILER_PS2_MOUSE, ps2_mouse_task())
+#    endif
+#    ifdef MIDI_ENABLE
+SCHEDULED_TASK(midi, TASK_PROFILER_MIDI, midi_task())
+#    endif
+#    ifdef JOYSTICK_ENABLE
+SCHEDULED_TASK(joystick, TASK_PROFILER_JOYSTICK, joystick_task())
+#    endif
+#    ifdef BLUETOOTH_ENABLE
+SCHEDULED_TASK(bluetooth, TASK_PROFILER_BLUETOOTH, bluetooth_task())
+#    endif
+#    ifdef SEND_STRING_ASYNC_ENABLE
+SCHEDULED_TASK(send_string_async, TASK_PROFILER_SEND_STRING_ASYNC, send_string_async_task())
+#    endif
+#    ifdef HAPTIC_ENABLE
+SCHEDULED_TASK(haptic, TASK_PROFILER_HAPTIC, haptic_task())
+#    endif
+SCHEDULED_TASK(led, TASK_PROFILER_LED, led_task())
+#    ifdef OS_DETECTION_ENABLE
+SCHEDULED_TASK(os_detection, TASK_PROFILER_OS_DETECTION, os_detection_task())
+#    endif
+#    if defined(DYNAMIC_KEYMAP_ENABLE) && defined(DYNAMIC_KEYMAP_RAM_SHADOW)
+SCHEDULED_TASK(dynamic_keymap, TASK_PROFILER_DYNAMIC_KEYMAP, dynamic_keymap_task())
+#    endif
+
+#    define REGISTER_TASK(name, priority) task_scheduler_register(name##_scheduled_task, #name, 0, priority, TASK_SCHEDULER_DEFAULT_BUDGET)
+
+/** \brief Registers the background tasks with the scheduler
+ *
+ * All of them already throttle themselves, so they are registered to run on
+ * every pass. Whatever talks to the host comes before lighting and displays.
+ */
+static void keyboard_task_scheduler_init(void) {
+#    if defined(SPLIT_WATCHDOG_ENABLE)
+    REGISTER_TASK(split_watchdog, TASK_SCHEDULER_PRIORITY_HIGH);
+#    endif
+#    ifdef MOUSEKEY_ENABLE
+    REGISTER_TASK(mousekey, TASK_SCHEDULER_PRIORITY_HIGH);
+#    endif
+#    ifdef PS2_MOUSE_ENABLE
+    REGISTER_TASK(ps2_mouse, TASK_SCHEDULER_PRIORITY_HIGH);
+#    endif
+#    ifdef JOYSTICK_ENABLE
+    REGISTER_TASK(joystick, TASK_SCHEDULER_PRIORITY_HIGH);
+#    endif
+#    ifdef MIDI_ENABLE
+    REGISTER_TASK(midi, TASK_SCHEDULER_PRIORITY_HIGH);
+#    endif
+#    ifdef BLUETOOTH_ENABLE
+    REGISTER_TASK(bluetooth, TASK_SCHEDULER_PRIORITY_HIGH);
+#    endif
+#    ifdef SEND_STRING_ASYNC_ENABLE
+    REGISTER_TASK(send_string_async, TASK_SCHEDULER_PRIORITY_HIGH);
+#    endif
+    REGISTER_TASK(led, TASK_SCHEDULER_PRIORITY_NORMAL);
+#    ifdef HAPTIC_ENABLE
+    REGISTER_TASK(haptic, TASK_SCHEDULER_PRIORITY_NORMAL);
+#    endif
+#    ifdef OS_DETECTION_ENABLE
+    REGISTER_TASK(os_detection, TASK_SCHEDULER_PRIORITY_NORMAL);
+#    endif
+#    if defined(RGBLIGHT_ENABLE)
+    REGISTER_TASK(rgblight, TASK_SCHEDULER_PRIORITY_LOW);
+#    endif
+#    ifdef LED_MATRIX_ENABLE
+    REGISTER_TASK(led_matrix, TASK_SCHEDULER_PRIORITY_LOW);
+#    endif
+#    ifdef RGB_MATRIX_ENABLE
+    REGISTER_TASK(rgb_matrix, TASK_SCHEDULER_PRIORITY_LOW);
+#    endif
+#    if defined(BACKLIGHT_ENABLE) && (defined(BACKLIGHT_PIN) || defined(BACKLIGHT_PINS))
+    REGISTER_TASK(backlight, TASK_SCHEDULER_PRIORITY_LOW);
+#    endif
+#    ifdef OLED_ENABLE
+    REGISTER_TASK(oled, TASK_SCHEDULER_PRIORITY_IDLE);
+#    endif
+#    ifdef ST7565_ENABLE
+    REGISTER_TASK(st7565, TASK_SCHEDULER_PRIORITY_IDLE);
+#    endif
+#    ifdef QUANTUM_PAINTER_ENABLE
+    REGISTER_TASK(quantum_painter, TASK_SCHEDULER_PRIORITY_IDLE);
+#    endif
+#    if defined(DYNAMIC_KEYMAP_ENABLE) && defined(DYNAMIC_KEYMAP_RAM_SHADOW)
+    REGISTER_TASK(dynamic_keymap, TASK_SCHEDULER_PRIORITY_IDLE);
+#    endif
+}
+#endif
+
 /** \brief keyboard_init
  *
  * FIXME: needs doc
@@ -485,10 +641,24 @@ void keyboard_init(void) {
 #ifdef HAPTIC_ENABLE
     haptic_init();
 #endif
+    // Sort the lookup indexes now rather than on the first keystroke
+    process_record_routes_init();
+#ifdef COMBO_ENABLE
+    combo_key_index_rebuild();
+#endif
+#ifdef KEY_OVERRIDE_ENABLE
+    key_override_index_rebuild();
+#endif
+#if defined(LEADER_ENABLE) && defined(LEADER_SEQUENCES_ENABLE)
+    leader_sequences_index_rebuild();
+#endif
 
 #if defined(DEBUG_MATRIX_SCAN_RATE) && defined(CONSOLE_ENABLE)
     debug_enable = true;
 #endif
+#ifdef TASK_SCHEDULER_ENABLE
+    keyboard_task_scheduler_init();
+#endif
 
     keyboard_post_init_kb(); /* Always keep this last */
 }
@@ -520,60 +690,149 @@ static inline void generate_tick_event(void) {
     }
 }
 
+#if (MATRIX_ROWS <= 8)
+typedef uint8_t matrix_changes_t;
+#elif (MATRIX_ROWS <= 16)
+typedef uint16_t matrix_changes_t;
+#elif (MATRIX_ROWS <= 32)
+typedef uint32_t matrix_changes_t;
+#else
+typedef uint64_t matrix_changes_t;
+#endif
+
+/**
+ * @brief Returns the index of the lowest set bit. `bits` must not be zero.
+ *
+ * Used to walk the changed rows and columns of the matrix in ascending order
+ * without testing every single bit.
+ */
+#if (MATRIX_ROWS <= 32) && (MATRIX_COLS <= 32)
+#    define matrix_lowest_bit(bits) ((uint8_t)__builtin_ctzl((unsigned long)(bits)))
+#else
+#    define matrix_lowest_bit(bits) ((uint8_t)__builtin_ctzll((unsigned long long)(bits)))
+#endif
+
+/**
+ * @brief Fallback for fully custom matrices, which have no way to tell when a
+ * change was first seen.
+ */
+__attribute__((weak)) uint16_t matrix_get_key_time(uint8_t row, uint8_t col) {
+    return timer_read();
+}
+
+/**
+ * @brief Returns the time the event of a changed key is stamped with.
+ *
+ * This is the time the matrix layer first saw the change, so tapping decisions
+ * do not depend on how long debounce or a slow main loop held the change back.
+ * Times are kept in dispatch order so the tapping state machine never sees a
+ * key event that is older than the one before it.
+ */
+static uint16_t matrix_key_event_time(uint8_t row, uint8_t col, uint16_t now) {
+    static uint16_t last_event_time = 0;
+
+    // The timer was reset, nothing dispatched before can be compared against
+    if (!timer_expired(now, last_event_time)) {
+        last_event_time = now;
+    }
+
+    uint16_t event_time = matrix_get_key_time(row, col);
+    if (!timer_expired(now, event_time)) {
+        event_time = now;
+    } else if (!timer_expired(event_time, last_event_time)) {
+        event_time = last_event_time;
+    }
+
+    last_event_time = event_time;
+    return event_time;
+}
+
 /**
  * @brief This task scans the keyboards matrix and processes any key presses
  * that occur.
  *
+ * Changed rows are collected into a bitmap while diffing against the previous
+ * state, so only rows and columns that actually changed are visited when
+ * generating key events.
+ *
+ * With KEY_EVENT_QUEUE_ENABLE the key events are queued instead, and
+ * key_event_queue_task() processes them. A change that does not fit into the
+ * queue is left out of matrix_previous, so the next scan picks it up again.
+ * With KEY_EVENT_QUEUE_ASYNC_SCAN this runs outside the main loop, so it does
+ * nothing but scan and queue; debug output is left to the main loop.
+ *
  * @return true Matrix did change
  * @return false Matrix didn't change
  */
 static bool matrix_task(void) {
     if (!matrix_can_read()) {
+#ifndef KEY_EVENT_QUEUE_ENABLE
         generate_tick_event();
+#endif
         return false;
     }
 
     static matrix_row_t matrix_previous[MATRIX_ROWS];
 
     matrix_scan();
-    bool matrix_changed = false;
-    for (uint8_t row = 0; row < MATRIX_ROWS && !matrix_changed; row++) {
-        matrix_changed |= matrix_previous[row] ^ matrix_get_row(row);
+    matrix_changes_t changed_rows = 0;
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        if (matrix_previous[row] ^ matrix_get_row(row)) {
+            changed_rows |= (matrix_changes_t)1 << row;
+        }
     }
+    const bool matrix_changed = changed_rows != 0;
 
+#ifndef KEY_EVENT_QUEUE_ASYNC_SCAN
     matrix_scan_perf_task();
+#endif
 
     // Short-circuit the complete matrix processing if it is not necessary
     if (!matrix_changed) {
+#ifndef KEY_EVENT_QUEUE_ENABLE
         generate_tick_event();
+#endif
         return matrix_changed;
     }
 
+#ifndef KEY_EVENT_QUEUE_ASYNC_SCAN
     if (debug_config.matrix) {
         matrix_print();
     }
+#endif
 
+#ifndef KEY_EVENT_QUEUE_ENABLE
     const bool process_keypress = should_process_keypress();
+#endif
+    const uint16_t now = timer_read();
 
-    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+    for (; changed_rows; changed_rows &= changed_rows - 1) {
+        const uint8_t      row         = matrix_lowest_bit(changed_rows);
         const matrix_row_t current_row = matrix_get_row(row);
-        const matrix_row_t row_changes = current_row ^ matrix_previous[row];
+        matrix_row_t       row_changes = current_row ^ matrix_previous[row];
 
-        if (!row_changes || has_ghost_in_row(row, current_row)) {
+        if (has_ghost_in_row(row, current_row)) {
             continue;
         }
 
-        matrix_row_t col_mask = 1;
-        for (uint8_t col = 0; col < MATRIX_COLS; col++, col_mask <<= 1) {
-            if (row_changes & col_mask) {
-                const bool key_pressed = current_row & col_mask;
+        for (; row_changes; row_changes &= row_changes - 1) {
+            const uint8_t  col         = matrix_lowest_bit(row_changes);
+            const bool     key_pressed = current_row & (MATRIX_ROW_SHIFTER << col);
+            const uint16_t event_time  = matrix_key_event_time(row, col, now);
 
-                if (process_keypress) {
-                    action_exec(MAKE_KEYEVENT(row, col, key_pressed));
-                }
-
-                switch_events(row, col, key_pressed);
+#ifdef KEY_EVENT_QUEUE_ENABLE
+            if (!key_event_queue_push(MAKE_KEYEVENT_AT(row, col, key_pressed, event_time))) {
+                // Queue full: acknowledge what was queued and retry the rest on the next scan
+                matrix_previous[row] ^= (current_row ^ matrix_previous[row]) & ~row_changes;
+                return matrix_changed;
+            }
+#else
+            if (process_keypress) {
+                action_exec(MAKE_KEYEVENT_AT(row, col, key_pressed, event_time));
             }
+
+            switch_events(row, col, key_pressed);
+#endif
         }
 
         matrix_previous[row] = current_row;
@@ -582,6 +841,74 @@ static bool matrix_task(void) {
     return matrix_changed;
 }
 
+#ifdef KEY_EVENT_QUEUE_ENABLE
+bool keyboard_scan_task(void) {
+    return matrix_task();
+}
+
+/**
+ * @brief Processes the key events queued by the matrix scan, or generates a
+ * tick event if there are none.
+ *
+ * @return true if any key event was processed
+ */
+static bool key_event_queue_task(void) {
+    keyevent_t event;
+    bool       processed = false;
+
+    while (key_event_queue_pop(&event)) {
+        if (should_process_keypress()) {
+            action_exec(event);
+        }
+        switch_events(event.key.row, event.key.col, event.pressed);
+        processed = true;
+    }
+
+    if (!processed) {
+        generate_tick_event();
+    }
+#    ifdef KEY_EVENT_QUEUE_ASYNC_SCAN
+    else if (debug_config.matrix) {
+        matrix_print();
+    }
+#    endif
+    return processed;
+}
+#endif
+
+#ifdef MATRIX_IDLE_WAIT_ENABLE
+/** \brief matrix_idle_wait_task
+ *
+ * Once there has been no input for MATRIX_IDLE_WAIT_TIMEOUT and no switch is held, blocks until a switch edge
+ * occurs, the next deferred executor is due, or MATRIX_IDLE_WAIT_MAX elapses, whichever comes first.
+ */
+static void matrix_idle_wait_task(void) {
+    if (last_input_activity_elapsed() < MATRIX_IDLE_WAIT_TIMEOUT) {
+        return;
+    }
+
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        if (matrix_get_row(row)) {
+            return;
+        }
+    }
+
+    uint32_t timeout_ms = MATRIX_IDLE_WAIT_MAX;
+#    ifdef DEFERRED_EXEC_ENABLE
+    timeout_ms = MIN(timeout_ms, deferred_exec_time_until_next());
+#    endif
+#    ifdef SEND_STRING_ASYNC_ENABLE
+    timeout_ms = MIN(timeout_ms, send_string_async_time_until_next());
+#    endif
+#    ifdef HOST_REPORT_QUEUE_ENABLE
+    timeout_ms = MIN(timeout_ms, host_report_queue_time_until_next());
+#    endif
+    if (timeout_ms > 0) {
+        matrix_idle_wait(timeout_ms);
+    }
+}
+#endif
+
 /** \brief Tasks previously located in matrix_scan_quantum
  *
  * TODO: rationalise against keyboard_task and current split role
@@ -613,139 +940,216 @@ void quantum_task(void) {
 #endif
 
 #if defined(AUDIO_ENABLE) && !defined(NO_MUSIC_MODE)
-    music_task();
+    TASK_PROFILE(TASK_PROFILER_MUSIC, music_task());
 #endif
 
 #ifdef KEY_OVERRIDE_ENABLE
-    key_override_task();
+    TASK_PROFILE(TASK_PROFILER_KEY_OVERRIDE, key_override_task());
 #endif
 
 #ifdef SEQUENCER_ENABLE
-    sequencer_task();
+    TASK_PROFILE(TASK_PROFILER_SEQUENCER, sequencer_task());
 #endif
 
 #ifdef TAP_DANCE_ENABLE
-    tap_dance_task();
+    TASK_PROFILE(TASK_PROFILER_TAP_DANCE, tap_dance_task());
 #endif
 
 #ifdef COMBO_ENABLE
-    combo_task();
+    TASK_PROFILE(TASK_PROFILER_COMBO, combo_task());
 #endif
 
 #ifdef LEADER_ENABLE
-    leader_task();
+    TASK_PROFILE(TASK_PROFILER_LEADER, leader_task());
+#endif
+
+#if defined(STENO_ENABLE) && defined(STENO_OUTPUT_QUEUE)
+    TASK_PROFILE(TASK_PROFILER_STENO, steno_output_queue_task());
 #endif
 
 #ifdef WPM_ENABLE
-    decay_wpm();
+    TASK_PROFILE(TASK_PROFILER_WPM, decay_wpm());
 #endif
 
 #ifdef DIP_SWITCH_ENABLE
-    dip_switch_task();
+    TASK_PROFILE(TASK_PROFILER_DIP_SWITCH, dip_switch_task());
 #endif
 
 #ifdef AUTO_SHIFT_ENABLE
-    autoshift_matrix_scan();
+    TASK_PROFILE(TASK_PROFILER_AUTO_SHIFT, autoshift_matrix_scan());
 #endif
 
 #ifdef CAPS_WORD_ENABLE
-    caps_word_task();
+    TASK_PROFILE(TASK_PROFILER_CAPS_WORD, caps_word_task());
 #endif
 
 #ifdef SECURE_ENABLE
-    secure_task();
+    TASK_PROFILE(TASK_PROFILER_SECURE, secure_task());
 #endif
 }
 
-/** \brief Main task that is repeatedly called as fast as possible. */
-void keyboard_task(void) {
+/** \brief Services the encoders and the pointing device
+ *
+ * \return true if any of them reported activity
+ */
+static bool input_device_task(void) {
     __attribute__((unused)) bool activity_has_occurred = false;
-    if (matrix_task()) {
-        last_matrix_activity_trigger();
+
+#ifdef ENCODER_ENABLE
+    bool encoder_changed;
+    TASK_PROFILE(TASK_PROFILER_ENCODER, encoder_changed = encoder_task());
+    if (encoder_changed) {
+        last_encoder_activity_trigger();
         activity_has_occurred = true;
     }
-
-    quantum_task();
-
-#if defined(SPLIT_WATCHDOG_ENABLE)
-    split_watchdog_task();
 #endif
 
-#if defined(RGBLIGHT_ENABLE)
-    rgblight_task();
+#ifdef POINTING_DEVICE_ENABLE
+    bool pointing_device_changed;
+    TASK_PROFILE(TASK_PROFILER_POINTING_DEVICE, pointing_device_changed = pointing_device_task());
+    if (pointing_device_changed) {
+        last_pointing_device_activity_trigger();
+        activity_has_occurred = true;
+    }
 #endif
 
-#ifdef LED_MATRIX_ENABLE
-    led_matrix_task();
+    return activity_has_occurred;
+}
+
+/** \brief Main task that is repeatedly called as fast as possible. */
+void keyboard_task(void) {
+#ifdef TASK_PROFILER_ENABLE
+    uint32_t loop_start = task_profiler_timestamp();
 #endif
-#ifdef RGB_MATRIX_ENABLE
-    rgb_matrix_task();
+    __attribute__((unused)) bool activity_has_occurred = false;
+#ifdef MATRIX_IDLE_WAIT_ENABLE
+    matrix_idle_wait_task();
+#endif
+    bool matrix_changed;
+#ifdef KEY_EVENT_QUEUE_ENABLE
+    bool key_events_processed;
+#    ifdef KEY_EVENT_QUEUE_ASYNC_SCAN
+    // The keyboard scans from its own interrupt or thread, only drain the queue and run the scan callbacks here
+    matrix_changed = false;
+    TASK_PROFILE(TASK_PROFILER_MATRIX, matrix_scan_kb());
+#    else
+    TASK_PROFILE(TASK_PROFILER_MATRIX, matrix_changed = matrix_task());
+#    endif
+    TASK_PROFILE(TASK_PROFILER_KEY_EVENT_QUEUE, key_events_processed = key_event_queue_task());
+    matrix_changed |= key_events_processed;
+#else
+    TASK_PROFILE(TASK_PROFILER_MATRIX, matrix_changed = matrix_task());
 #endif
+    if (matrix_changed) {
+        last_matrix_activity_trigger();
+        activity_has_occurred = true;
+    }
 
-#if defined(BACKLIGHT_ENABLE)
-#    if defined(BACKLIGHT_PIN) || defined(BACKLIGHT_PINS)
-    backlight_task();
-#    endif
+    TASK_PROFILE(TASK_PROFILER_QUANTUM, quantum_task());
+
+#ifdef HOST_REPORT_QUEUE_ENABLE
+    TASK_PROFILE(TASK_PROFILER_HOST_REPORT_QUEUE, host_report_queue_task());
 #endif
 
-#ifdef ENCODER_ENABLE
-    if (encoder_task()) {
-        last_encoder_activity_trigger();
+#ifdef TASK_SCHEDULER_ENABLE
+    // Input is serviced on every pass, everything else within the scheduler's loop budget
+    if (input_device_task()) {
         activity_has_occurred = true;
     }
-#endif
 
-#ifdef POINTING_DEVICE_ENABLE
-    if (pointing_device_task()) {
-        last_pointing_device_activity_trigger();
+#    if defined(OLED_ENABLE) && OLED_TIMEOUT > 0
+    if (activity_has_occurred) oled_on();
+#    endif
+#    if defined(ST7565_ENABLE) && ST7565_TIMEOUT > 0
+    if (activity_has_occurred) st7565_on();
+#    endif
+
+    task_scheduler_run();
+#else
+#    if defined(SPLIT_WATCHDOG_ENABLE)
+    TASK_PROFILE(TASK_PROFILER_SPLIT_WATCHDOG, split_watchdog_task());
+#    endif
+
+#    if defined(RGBLIGHT_ENABLE)
+    TASK_PROFILE(TASK_PROFILER_RGBLIGHT, rgblight_task());
+#    endif
+
+#    ifdef LED_MATRIX_ENABLE
+    TASK_PROFILE(TASK_PROFILER_LED_MATRIX, led_matrix_task());
+#    endif
+#    ifdef RGB_MATRIX_ENABLE
+    TASK_PROFILE(TASK_PROFILER_RGB_MATRIX, rgb_matrix_task());
+#    endif
+
+#    if defined(BACKLIGHT_ENABLE)
+#        if defined(BACKLIGHT_PIN) || defined(BACKLIGHT_PINS)
+    TASK_PROFILE(TASK_PROFILER_BACKLIGHT, backlight_task());
+#        endif
+#    endif
+
+    if (input_device_task()) {
         activity_has_occurred = true;
     }
-#endif
 
-#ifdef OLED_ENABLE
-    oled_task();
-#    if OLED_TIMEOUT > 0
+#    ifdef OLED_ENABLE
+    TASK_PROFILE(TASK_PROFILER_OLED, oled_task());
+#        if OLED_TIMEOUT > 0
     // Wake up oled if user is using those fabulous keys or spinning those encoders!
     if (activity_has_occurred) oled_on();
+#        endif
 #    endif
-#endif
 
-#ifdef ST7565_ENABLE
-    st7565_task();
-#    if ST7565_TIMEOUT > 0
+#    ifdef ST7565_ENABLE
+    TASK_PROFILE(TASK_PROFILER_ST7565, st7565_task());
+#        if ST7565_TIMEOUT > 0
     // Wake up display if user is using those fabulous keys or spinning those encoders!
     if (activity_has_occurred) st7565_on();
+#        endif
 #    endif
-#endif
 
-#ifdef MOUSEKEY_ENABLE
+#    ifdef MOUSEKEY_ENABLE
     // mousekey repeat & acceleration
-    mousekey_task();
-#endif
+    TASK_PROFILE(TASK_PROFILER_MOUSEKEY, mousekey_task());
+#    endif
 
-#ifdef PS2_MOUSE_ENABLE
-    ps2_mouse_task();
-#endif
+#    ifdef PS2_MOUSE_ENABLE
+    TASK_PROFILE(TASK_PROFILER_PS2_MOUSE, ps2_mouse_task());
+#    endif
 
-#ifdef MIDI_ENABLE
-    midi_task();
-#endif
+#    ifdef MIDI_ENABLE
+    TASK_PROFILE(TASK_PROFILER_MIDI, midi_task());
+#    endif
 
-#ifdef JOYSTICK_ENABLE
-    joystick_task();
-#endif
+#    ifdef JOYSTICK_ENABLE
+    TASK_PROFILE(TASK_PROFILER_JOYSTICK, joystick_task());
+#    endif
 
-#ifdef BLUETOOTH_ENABLE
-    bluetooth_task();
-#endif
+#    ifdef BLUETOOTH_ENABLE
+    TASK_PROFILE(TASK_PROFILER_BLUETOOTH, bluetooth_task());
+#    endif
 
-#ifdef HAPTIC_ENABLE
-    haptic_task();
-#endif
+#    ifdef SEND_STRING_ASYNC_ENABLE
+    TASK_PROFILE(TASK_PROFILER_SEND_STRING_ASYNC, send_string_async_task());
+#    endif
 
-    led_task();
+#    ifdef HAPTIC_ENABLE
+    TASK_PROFILE(TASK_PROFILER_HAPTIC, haptic_task());
+#    endif
 
-#ifdef OS_DETECTION_ENABLE
-    os_detection_task();
+    TASK_PROFILE(TASK_PROFILER_LED, led_task());
+
+#    ifdef OS_DETECTION_ENABLE
+    TASK_PROFILE(TASK_PROFILER_OS_DETECTION, os_detection_task());
+#    endif
+
+#    if defined(DYNAMIC_KEYMAP_ENABLE) && defined(DYNAMIC_KEYMAP_RAM_SHADOW)
+    // write back keymap changes made over VIA
+    TASK_PROFILE(TASK_PROFILER_DYNAMIC_KEYMAP, dynamic_keymap_task());
+#    endif
+#endif
+
+#ifdef TASK_PROFILER_ENABLE
+    task_profiler_record(TASK_PROFILER_KEYBOARD, loop_start);
+    task_profiler_task();
 #endif
 }
@@ -171,3 +171,41 @@ __attribute__((weak)) const key_override_t* key_override_get(uint16_t key_overri
 }
 
 #endif // defined(KEY_OVERRIDE_ENABLE)
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Leader Sequences
+
+#if defined(LEADER_ENABLE) && defined(LEADER_SEQUENCES_ENABLE)
+
+uint16_t leader_sequences_count_raw(void) {
+    return ARRAY_SIZE(leader_sequences);
+}
+
+__attribute__((weak)) uint16_t leader_sequences_count(void) {
+    return leader_sequences_count_raw();
+}
+
+uint16_t leader_sequences_get_key_raw(uint16_t sequence_idx, uint16_t key_idx) {
+    if (sequence_idx >= leader_sequences_count_raw()) {
+        return LEADER_SEQUENCE_END;
+    }
+    const uint16_t* keys = pgm_read_ptr(&leader_sequences[sequence_idx].keys);
+    return pgm_read_word(&keys[key_idx]);
+}
+
+__attribute__((weak)) uint16_t leader_sequences_get_key(uint16_t sequence_idx, uint16_t key_idx) {
+    return leader_sequences_get_key_raw(sequence_idx, key_idx);
+}
+
+uint16_t leader_sequences_get_keycode_raw(uint16_t sequence_idx) {
+    if (sequence_idx >= leader_sequences_count_raw()) {
+        return KC_NO;
+    }
+    return pgm_read_word(&leader_sequences[sequence_idx].keycode);
+}
+
+__attribute__((weak)) uint16_t leader_sequences_get_keycode(uint16_t sequence_idx) {
+    return leader_sequences_get_keycode_raw(sequence_idx);
+}
+
+#endif // defined(LEADER_ENABLE) && defined(LEADER_SEQUENCES_ENABLE)
@@ -109,3 +109,25 @@ const key_override_t* key_override_get_raw(uint16_t key_override_idx);
 const key_override_t* key_override_get(uint16_t key_override_idx);
 
 #endif // defined(KEY_OVERRIDE_ENABLE)
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Leader Sequences
+
+#if defined(LEADER_ENABLE) && defined(LEADER_SEQUENCES_ENABLE)
+
+// Get the number of leader sequences defined in the user's keymap, stored in firmware rather than any other persistent storage
+uint16_t leader_sequences_count_raw(void);
+// Get the number of leader sequences defined in the user's keymap, potentially stored dynamically
+uint16_t leader_sequences_count(void);
+
+// Get a key of a leader sequence, stored in firmware rather than any other persistent storage. Only valid up to the sequence's LEADER_SEQUENCE_END
+uint16_t leader_sequences_get_key_raw(uint16_t sequence_idx, uint16_t key_idx);
+// Get a key of a leader sequence, potentially stored dynamically. Only valid up to the sequence's LEADER_SEQUENCE_END
+uint16_t leader_sequences_get_key(uint16_t sequence_idx, uint16_t key_idx);
+
+// Get the keycode tapped by a leader sequence, stored in firmware rather than any other persistent storage
+uint16_t leader_sequences_get_keycode_raw(uint16_t sequence_idx);
+// Get the keycode tapped by a leader sequence, potentially stored dynamically
+uint16_t leader_sequences_get_keycode(uint16_t sequence_idx);
+
+#endif // defined(LEADER_ENABLE) && defined(LEADER_SEQUENCES_ENABLE)
@@ -7,6 +7,13 @@
 
 #include <string.h>
 
+#ifdef LEADER_SEQUENCES_ENABLE
+#    include "quantum.h"
+#    include "debug.h"
+#    include "keymap_introspection.h"
+#    include "sorted_index.h"
+#endif
+
 #ifndef LEADER_TIMEOUT
 #    define LEADER_TIMEOUT 300
 #endif
@@ -17,10 +24,152 @@ uint16_t leader_time          = 0;
 uint16_t leader_sequence[5]   = {0, 0, 0, 0, 0};
 uint8_t  leader_sequence_size = 0;
 
+#ifdef LEADER_SEQUENCES_ENABLE
+#    define LEADER_SEQUENCE_NONE UINT16_MAX
+
+/* Sequence indices sorted by their keys, shorter sequences first. All sequences
+ * starting with the keys typed so far form one contiguous range of it, which
+ * acts as the current node of a prefix trie: each key narrows the range down
+ * with two binary searches at the next depth. */
+static uint16_t leader_sequences_index[LEADER_SEQUENCES_INDEX_SIZE];
+static uint16_t leader_sequences_index_size = 0;
+
+static sorted_index_state_t leader_sequences_index_state = SORTED_INDEX_INVALID;
+
+// Number of keys typed, and the sequences starting with them: a range of the index, or just the first of them when scanning
+static uint16_t leader_sequences_depth = 0;
+static uint16_t leader_sequences_first = 0;
+static uint16_t leader_sequences_last  = 0;
+// Number of sequences starting with the keys typed, the first which is exactly them, and whether any is longer
+static uint16_t leader_sequences_candidates = 0;
+static uint16_t leader_sequences_match      = LEADER_SEQUENCE_NONE;
+static bool     leader_sequences_longer     = false;
+#endif
+
 __attribute__((weak)) void leader_start_user(void) {}
 
 __attribute__((weak)) void leader_end_user(void) {}
 
+#ifdef LEADER_SEQUENCES_ENABLE
+__attribute__((weak)) void process_leader_sequence_event(uint16_t sequence_index) {}
+
+/* Compares the keys of two sequences, shorter sequences first */
+static int leader_sequences_compare(const void *a, const void *b) {
+    for (uint16_t i = 0;; ++i) {
+        uint16_t key_a = leader_sequences_get_key(*(const uint16_t *)a, i);
+        uint16_t key_b = leader_sequences_get_key(*(const uint16_t *)b, i);
+        if (key_a != key_b) {
+            return key_a < key_b ? -1 : 1;
+        }
+        if (key_a == LEADER_SEQUENCE_END) {
+            return 0;
+        }
+    }
+}
+
+void leader_sequences_index_rebuild(void) {
+    uint16_t count              = leader_sequences_count();
+    leader_sequences_index_size = 0;
+
+    if (count > LEADER_SEQUENCES_INDEX_SIZE) {
+        sorted_index_print_overflow("leader", count, "sequences", LEADER_SEQUENCES_INDEX_SIZE);
+        leader_sequences_index_state = SORTED_INDEX_OVERFLOW;
+        return;
+    }
+
+    for (uint16_t i = 0; i < count; ++i) {
+        // Identical sequences stay in table order, so the first of them wins
+        sorted_index_insert(leader_sequences_index, &leader_sequences_index_size, sizeof(uint16_t), &i, leader_sequences_compare);
+    }
+
+    leader_sequences_index_state = SORTED_INDEX_VALID;
+}
+
+static void leader_sequences_reset(void) {
+    leader_sequences_depth      = 0;
+    leader_sequences_first      = 0;
+    leader_sequences_last       = leader_sequences_index_size;
+    leader_sequences_candidates = leader_sequences_count();
+    leader_sequences_match      = LEADER_SEQUENCE_NONE;
+    leader_sequences_longer     = false;
+}
+
+/* Compares the key of a sequence at the current depth against a keycode */
+static int leader_sequences_compare_key(const void *sequence, const void *keycode) {
+    uint16_t key = leader_sequences_get_key(*(const uint16_t *)sequence, leader_sequences_depth);
+    return key < *(const uint16_t *)keycode ? -1 : key > *(const uint16_t *)keycode;
+}
+
+/* Returns the first position in the current range whose key at the current depth is not below `keycode` */
+static uint16_t leader_sequences_lower_bound(uint16_t keycode) {
+    return sorted_index_lower_bound(leader_sequences_index, leader_sequences_first, leader_sequences_last, sizeof(uint16_t), &keycode, leader_sequences_compare_key);
+}
+
+/* Narrows the index range down to the sequences continuing with `keycode` */
+static void leader_sequences_advance_indexed(uint16_t keycode) {
+    uint16_t first = leader_sequences_lower_bound(keycode);
+    uint16_t last  = keycode == UINT16_MAX ? leader_sequences_last : leader_sequences_lower_bound(keycode + 1);
+
+    leader_sequences_first      = first;
+    leader_sequences_last       = last;
+    leader_sequences_candidates = last - first;
+    leader_sequences_depth++;
+
+    // Sequences ending here sort first, longer ones last
+    if (first < last) {
+        if (leader_sequences_get_key(leader_sequences_index[first], leader_sequences_depth) == LEADER_SEQUENCE_END) {
+            leader_sequences_match = leader_sequences_index[first];
+        }
+        leader_sequences_longer = leader_sequences_get_key(leader_sequences_index[last - 1], leader_sequences_depth) != LEADER_SEQUENCE_END;
+    }
+}
+
+/* Looks for the sequences continuing with `keycode` among all of them, keeping the first as a reference for the keys typed */
+static void leader_sequences_advance_linear(uint16_t keycode) {
+    uint16_t reference = leader_sequences_first;
+
+    leader_sequences_candidates = 0;
+    for (uint16_t i = 0; i < leader_sequences_count(); ++i) {
+        uint16_t depth = 0;
+        while (depth < leader_sequences_depth && leader_sequences_get_key(i, depth) == leader_sequences_get_key(reference, depth)) {
+            depth++;
+        }
+        if (depth < leader_sequences_depth || leader_sequences_get_key(i, depth) != keycode) {
+            continue;
+        }
+
+        if (leader_sequences_candidates++ == 0) {
+            leader_sequences_first = i;
+        }
+        if (leader_sequences_get_key(i, depth + 1) != LEADER_SEQUENCE_END) {
+            leader_sequences_longer = true;
+        } else if (leader_sequences_match == LEADER_SEQUENCE_NONE) {
+            leader_sequences_match = i;
+        }
+    }
+    leader_sequences_depth++;
+}
+
+static void leader_sequences_advance(uint16_t keycode) {
+    leader_sequences_match  = LEADER_SEQUENCE_NONE;
+    leader_sequences_longer = false;
+    if (leader_sequences_candidates == 0) {
+        return;
+    }
+
+    if (leader_sequences_index_state == SORTED_INDEX_VALID) {
+        leader_sequences_advance_indexed(keycode);
+    } else {
+        leader_sequences_advance_linear(keycode);
+    }
+}
+
+bool leader_sequence_complete(void) {
+    // Identical sequences after the first can never match, so they do not count
+    return leader_sequences_match != LEADER_SEQUENCE_NONE && !leader_sequences_longer;
+}
+#endif
+
 void leader_start(void) {
     if (leading) {
         return;
@@ -30,10 +179,25 @@ void leader_start(void) {
     leader_time          = timer_read();
     leader_sequence_size = 0;
     memset(leader_sequence, 0, sizeof(leader_sequence));
+#ifdef LEADER_SEQUENCES_ENABLE
+    leader_sequences_reset();
+#endif
 }
 
 void leader_end(void) {
     leading = false;
+#ifdef LEADER_SEQUENCES_ENABLE
+    if (leader_sequences_match != LEADER_SEQUENCE_NONE) {
+        uint16_t sequence_index = leader_sequences_match;
+        uint16_t keycode        = leader_sequences_get_keycode(sequence_index);
+
+        leader_sequences_match = LEADER_SEQUENCE_NONE;
+        if (keycode != KC_NO) {
+            tap_code16(keycode);
+        }
+        process_leader_sequence_event(sequence_index);
+    }
+#endif
     leader_end_user();
 }
 
@@ -48,7 +212,18 @@ bool leader_sequence_active(void) {
 }
 
 bool leader_sequence_add(uint16_t keycode) {
+#ifdef LEADER_SEQUENCES_ENABLE
+    leader_sequences_advance(keycode);
+#endif
+
     if (leader_sequence_size >= ARRAY_SIZE(leader_sequence)) {
+#ifdef LEADER_SEQUENCES_ENABLE
+        // Sequences from the table are not limited by the buffer, which no longer matches any keys once it overflows
+        if (leader_sequences_candidates > 0) {
+            leader_sequence_size = ARRAY_SIZE(leader_sequence) + 1;
+            return true;
+        }
+#endif
         return false;
     }
 
@@ -77,7 +252,7 @@ void leader_reset_timer(void) {
 }
 
 bool leader_sequence_is(uint16_t kc1, uint16_t kc2, uint16_t kc3, uint16_t kc4, uint16_t kc5) {
-    return leader_sequence[0] == kc1 && leader_sequence[1] == kc2 && leader_sequence[2] == kc3 && leader_sequence[3] == kc4 && leader_sequence[4] == kc5;
+    return leader_sequence_size <= ARRAY_SIZE(leader_sequence) && leader_sequence[0] == kc1 && leader_sequence[1] == kc2 && leader_sequence[2] == kc3 && leader_sequence[3] == kc4 && leader_sequence[4] == kc5;
 }
 
 bool leader_sequence_one_key(uint16_t kc) {
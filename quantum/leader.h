@@ -1,9 +1,15 @@
 // Copyright 2023 QMK
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#pragma once
+
 #include <stdbool.h>
 #include <stdint.h>
 
+#if defined(LEADER_SEQUENCES_ENABLE) && !defined(LEADER_SEQUENCES_INDEX_SIZE)
+#    define LEADER_SEQUENCES_INDEX_SIZE 256
+#endif
+
 /**
  * \file
  *
@@ -45,7 +51,7 @@ bool leader_sequence_active(void);
  *
  * \param keycode The keycode to add.
  *
- * \return `true` if the keycode was added, `false` if the buffer is full.
+ * \return `true` if the keycode was added, `false` if the buffer is full and no sequence from the `leader_sequences` table continues with it.
  */
 bool leader_sequence_add(uint16_t keycode);
 
@@ -116,4 +122,41 @@ bool leader_sequence_four_keys(uint16_t kc1, uint16_t kc2, uint16_t kc3, uint16_
  */
 bool leader_sequence_five_keys(uint16_t kc1, uint16_t kc2, uint16_t kc3, uint16_t kc4, uint16_t kc5);
 
+#if defined(LEADER_SEQUENCES_ENABLE) || defined(__DOXYGEN__)
+
+/**
+ * A leader sequence from the `leader_sequences` table: the keys to type after the leader key, and the keycode to tap when they have been typed.
+ */
+typedef struct leader_sequence_t {
+    const uint16_t *keys;
+    uint16_t        keycode;
+} leader_sequence_t;
+
+#    define LEADER_SEQUENCE(ks, kc) \
+        { .keys = &(ks)[0], .keycode = (kc) }
+#    define LEADER_SEQUENCE_ACTION(ks) \
+        { .keys = &(ks)[0] }
+#    define LEADER_SEQUENCE_END 0
+
+/**
+ * \brief Invoked when a sequence from the `leader_sequences` table has been typed, after its keycode is tapped.
+ *
+ * \param sequence_index The index of the sequence in the table.
+ */
+void process_leader_sequence_event(uint16_t sequence_index);
+
+/**
+ * Whether the keys typed so far are a sequence from the `leader_sequences` table that no other sequence in the table starts with.
+ *
+ * The leader sequence ends as soon as this is the case, without waiting for the timeout.
+ */
+bool leader_sequence_complete(void);
+
+/**
+ * Sorts the `leader_sequences` table into its index, which keyboard_init() does once. Call this again whenever `leader_sequences_count()` or the sequences change.
+ */
+void leader_sequences_index_rebuild(void);
+
+#endif
+
 /** \} */
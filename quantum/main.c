@@ -15,6 +15,7 @@
  */
 
 #include "keyboard.h"
+#include "task_profiler.h"
 
 void platform_setup(void);
 
@@ -46,32 +47,32 @@ int main(void) {
 
     /* Main loop */
     while (true) {
-        protocol_pre_task();
+        TASK_PROFILE(TASK_PROFILER_PROTOCOL_PRE, protocol_pre_task());
         protocol_keyboard_task();
-        protocol_post_task();
+        TASK_PROFILE(TASK_PROFILER_PROTOCOL_POST, protocol_post_task());
 
 #ifdef RAW_ENABLE
         void raw_hid_task(void);
-        raw_hid_task();
+        TASK_PROFILE(TASK_PROFILER_RAW_HID, raw_hid_task());
 #endif
 
 #ifdef CONSOLE_ENABLE
         void console_task(void);
-        console_task();
+        TASK_PROFILE(TASK_PROFILER_CONSOLE, console_task());
 #endif
 
-#ifdef QUANTUM_PAINTER_ENABLE
-        // Run Quantum Painter task
+#if defined(QUANTUM_PAINTER_ENABLE) && !defined(TASK_SCHEDULER_ENABLE)
+        // Run Quantum Painter task, the scheduler runs it from keyboard_task() when enabled
         void qp_internal_task(void);
-        qp_internal_task();
+        TASK_PROFILE(TASK_PROFILER_QUANTUM_PAINTER, qp_internal_task());
 #endif
 
 #ifdef DEFERRED_EXEC_ENABLE
         // Run deferred executions
         void deferred_exec_task(void);
-        deferred_exec_task();
+        TASK_PROFILE(TASK_PROFILER_DEFERRED_EXEC, deferred_exec_task());
 #endif // DEFERRED_EXEC_ENABLE
 
-        housekeeping_task();
+        TASK_PROFILE(TASK_PROFILER_HOUSEKEEPING, housekeeping_task());
     }
 }
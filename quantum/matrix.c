@@ -21,6 +21,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "matrix.h"
 #include "debounce.h"
 #include "atomic_util.h"
+#ifdef MATRIX_IDLE_WAIT_ENABLE
+#    include "wakeup.h"
+#endif
 
 #ifdef SPLIT_KEYBOARD
 #    include "split_common/split_util.h"
@@ -172,6 +175,76 @@ __attribute__((weak)) void matrix_init_pins(void) {
     }
 }
 
+#            ifdef MATRIX_READ_COLS_BY_PORT
+/* A run of consecutive columns wired to consecutive pads of the same port.
+ * The whole run is extracted from the port state with a single shift and mask. */
+typedef struct {
+    uint8_t      port_index;
+    uint8_t      pad;
+    uint8_t      col;
+    matrix_row_t mask;
+} matrix_col_run_t;
+
+static gpio_port_t      col_ports[MATRIX_COLS];
+static uint8_t          col_port_count;
+static matrix_col_run_t col_runs[MATRIX_COLS];
+static uint8_t          col_run_count;
+
+static void matrix_init_col_runs(void) {
+    col_port_count = 0;
+    col_run_count  = 0;
+
+    matrix_col_run_t *run = NULL;
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        pin_t pin = col_pins[col];
+        if (pin == NO_PIN) {
+            run = NULL;
+            continue;
+        }
+
+        gpio_port_t port       = gpio_pin_port(pin);
+        uint8_t     port_index = 0;
+        while (port_index < col_port_count && col_ports[port_index] != port) {
+            port_index++;
+        }
+        if (port_index == col_port_count) {
+            col_ports[col_port_count++] = port;
+        }
+
+        uint8_t pad = gpio_pin_pad(pin);
+        if (run && run->port_index == port_index && run->pad + (col - run->col) == pad) {
+            run->mask = (run->mask << 1) | 1;
+            continue;
+        }
+
+        run             = &col_runs[col_run_count++];
+        run->port_index = port_index;
+        run->pad        = pad;
+        run->col        = col;
+        run->mask       = 1;
+    }
+}
+
+/* Reads every port used by the col pins once and gathers the pressed state of all columns. */
+static matrix_row_t matrix_read_col_ports(void) {
+    gpio_port_state_t port_states[MATRIX_COLS];
+    for (uint8_t i = 0; i < col_port_count; i++) {
+#                if MATRIX_INPUT_PRESSED_STATE == 0
+        port_states[i] = ~gpio_read_port(col_ports[i]);
+#                else
+        port_states[i] = gpio_read_port(col_ports[i]);
+#                endif
+    }
+
+    matrix_row_t row_value = 0;
+    for (uint8_t i = 0; i < col_run_count; i++) {
+        const matrix_col_run_t *run = &col_runs[i];
+        row_value |= ((matrix_row_t)(port_states[run->port_index] >> run->pad) & run->mask) << run->col;
+    }
+    return row_value;
+}
+#            endif
+
 __attribute__((weak)) void matrix_read_cols_on_row(matrix_row_t current_matrix[], uint8_t current_row) {
     // Start with a clear matrix row
     matrix_row_t current_row_value = 0;
@@ -181,6 +254,9 @@ __attribute__((weak)) void matrix_read_cols_on_row(matrix_row_t current_matrix[]
     }
     matrix_output_select_delay();
 
+#            ifdef MATRIX_READ_COLS_BY_PORT
+    current_row_value = matrix_read_col_ports();
+#            else
     // For each col...
     matrix_row_t row_shifter = MATRIX_ROW_SHIFTER;
     for (uint8_t col_index = 0; col_index < MATRIX_COLS; col_index++, row_shifter <<= 1) {
@@ -189,6 +265,7 @@ __attribute__((weak)) void matrix_read_cols_on_row(matrix_row_t current_matrix[]
         // Populate the matrix row with the state of the col pin
         current_row_value |= pin_state ? 0 : row_shifter;
     }
+#            endif
 
     // Unselect row
     unselect_row(current_row);
@@ -270,6 +347,60 @@ __attribute__((weak)) void matrix_read_rows_on_col(matrix_row_t current_matrix[]
 #    error DIODE_DIRECTION is not defined!
 #endif
 
+#ifdef MATRIX_IDLE_WAIT_ENABLE
+static bool matrix_wait_for_edge(const pin_t *inputs, uint8_t count, uint32_t timeout_ms) {
+    bool pressed   = false;
+    bool all_armed = true;
+    // Arm every input before sampling, so a press landing in between still wakes the wait
+    for (uint8_t i = 0; i < count; i++) {
+        if (inputs[i] != NO_PIN) {
+            all_armed &= gpio_enable_wakeup(inputs[i]);
+            pressed |= readMatrixPin(inputs[i]) == 0;
+        }
+    }
+
+    // An input sharing its interrupt line with another one can't wake the wait, so only doze for a scan's worth
+    if (!all_armed) {
+        timeout_ms = MIN(timeout_ms, 1);
+    }
+
+    bool woken = pressed || wakeup_wait(timeout_ms);
+
+    for (uint8_t i = 0; i < count; i++) {
+        if (inputs[i] != NO_PIN) {
+            gpio_disable_wakeup(inputs[i]);
+        }
+    }
+    return woken;
+}
+
+bool matrix_idle_wait(uint32_t timeout_ms) {
+#    if defined(DIRECT_PINS)
+    return matrix_wait_for_edge(&direct_pins[0][0], ROWS_PER_HAND * MATRIX_COLS, timeout_ms);
+#    elif defined(MATRIX_ROW_PINS) && defined(MATRIX_COL_PINS)
+    // Drive every output line at once so that any single switch press produces an input edge
+#        if (DIODE_DIRECTION == COL2ROW)
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        select_row(row);
+    }
+    matrix_output_select_delay();
+    bool woken = matrix_wait_for_edge(col_pins, MATRIX_COLS, timeout_ms);
+    unselect_rows();
+#        elif (DIODE_DIRECTION == ROW2COL)
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        select_col(col);
+    }
+    matrix_output_select_delay();
+    bool woken = matrix_wait_for_edge(row_pins, ROWS_PER_HAND, timeout_ms);
+    unselect_cols();
+#        endif
+    return woken;
+#    else
+    return false;
+#    endif
+}
+#endif
+
 void matrix_init(void) {
 #ifdef SPLIT_KEYBOARD
     // Set pinout for right half if pinout for that half is defined
@@ -302,6 +433,9 @@ void matrix_init(void) {
 
     // initialize key pins
     matrix_init_pins();
+#if defined(MATRIX_READ_COLS_BY_PORT) && !defined(DIRECT_PINS) && defined(MATRIX_ROW_PINS) && defined(MATRIX_COL_PINS) && (DIODE_DIRECTION == COL2ROW)
+    matrix_init_col_runs();
+#endif
 
     // initialize matrix state: all keys off
     memset(matrix, 0, sizeof(matrix));
@@ -340,10 +474,15 @@ uint8_t matrix_scan(void) {
     if (changed) memcpy(raw_matrix, curr_matrix, sizeof(curr_matrix));
 
 #ifdef SPLIT_KEYBOARD
+    matrix_update_key_times(thisHand, ROWS_PER_HAND);
     changed = debounce(raw_matrix, matrix + thisHand, ROWS_PER_HAND, changed) | matrix_post_scan();
 #else
+    matrix_update_key_times(0, ROWS_PER_HAND);
     changed = debounce(raw_matrix, matrix, ROWS_PER_HAND, changed);
+#    ifndef KEY_EVENT_QUEUE_ASYNC_SCAN
+    // Called from keyboard_task() instead, see KEY_EVENT_QUEUE_ASYNC_SCAN
     matrix_scan_kb();
+#    endif
 #endif
     return (uint8_t)changed;
 }
@@ -65,6 +65,18 @@ void matrix_output_unselect_delay(uint8_t line, bool key_pressed);
 /* only for backwards compatibility. delay between changing matrix pin state and reading values */
 void matrix_io_delay(void);
 
+/* block until a switch may have changed state or timeout_ms elapses, see MATRIX_IDLE_WAIT_ENABLE */
+bool matrix_idle_wait(uint32_t timeout_ms);
+
+/* time of the first scan that saw the current pending change of a key */
+uint16_t matrix_get_key_time(uint8_t row, uint8_t col);
+#ifdef MATRIX_FIRST_EDGE_TIME
+/* record pending key changes, must be called before debounce() */
+void matrix_update_key_times(uint8_t first_row, uint8_t num_rows);
+#else
+static inline void matrix_update_key_times(uint8_t first_row, uint8_t num_rows) {}
+#endif
+
 /* power control */
 void matrix_power_up(void);
 void matrix_power_down(void);
@@ -0,0 +1,24 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#define MATRIX_ROWS 3
+#define MATRIX_COLS 14
+#define DIODE_DIRECTION COL2ROW
+
+/* Columns mix contiguous runs, reversed pads, gaps, NO_PIN and several ports. */
+#define MATRIX_ROW_PINS \
+    { MOCK_PIN(3, 0), MOCK_PIN(3, 1), MOCK_PIN(3, 2) }
+#define MATRIX_COL_PINS \
+    { MOCK_PIN(0, 0), MOCK_PIN(0, 1), MOCK_PIN(0, 2), MOCK_PIN(0, 3), MOCK_PIN(0, 4), MOCK_PIN(1, 7), MOCK_PIN(1, 6), MOCK_PIN(1, 5), NO_PIN, MOCK_PIN(2, 0), MOCK_PIN(2, 3), MOCK_PIN(0, 10), MOCK_PIN(0, 11), MOCK_PIN(3, 15) }
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "mock.h"
+
+#ifdef __cplusplus
+};
+#endif
@@ -0,0 +1,99 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "matrix.h"
+#include "matrix/tests/mock.h"
+}
+
+static const pin_t row_pins[MATRIX_ROWS] = MATRIX_ROW_PINS;
+static const pin_t col_pins[MATRIX_COLS] = MATRIX_COL_PINS;
+
+class Matrix : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        mock_reset();
+        matrix_init();
+        clear_expected();
+    }
+
+    void set_key(uint8_t row, uint8_t col, bool pressed) {
+        if (col_pins[col] != NO_PIN) {
+            mock_set_switch(row_pins[row], col_pins[col], pressed);
+            if (pressed) {
+                expected[row] |= MATRIX_ROW_SHIFTER << col;
+            } else {
+                expected[row] &= ~(MATRIX_ROW_SHIFTER << col);
+            }
+        }
+    }
+
+    void clear_expected() {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            expected[row] = 0;
+        }
+    }
+
+    void expect_matrix() {
+        matrix_scan();
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            EXPECT_EQ(matrix_get_row(row), expected[row]) << "row " << +row;
+        }
+    }
+
+    matrix_row_t expected[MATRIX_ROWS];
+};
+
+TEST_F(Matrix, NoKeysPressed) {
+    expect_matrix();
+}
+
+TEST_F(Matrix, EachKeyIsReadIndividually) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            set_key(row, col, true);
+            expect_matrix();
+            set_key(row, col, false);
+            expect_matrix();
+        }
+    }
+}
+
+TEST_F(Matrix, AllKeysPressed) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            set_key(row, col, true);
+        }
+    }
+    expect_matrix();
+}
+
+TEST_F(Matrix, RandomPatterns) {
+    uint32_t seed = 0x1234567;
+    for (int i = 0; i < 500; i++) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                seed = seed * 1103515245 + 12345;
+                set_key(row, col, (seed >> 16) & 1);
+            }
+        }
+        expect_matrix();
+    }
+}
+
+TEST_F(Matrix, ColumnReadsPerScan) {
+    mock_pin_reads  = 0;
+    mock_port_reads = 0;
+    matrix_scan();
+#ifdef MATRIX_READ_COLS_BY_PORT
+    // Columns span four ports, each read once per row
+    EXPECT_EQ(mock_port_reads, 4 * MATRIX_ROWS);
+    EXPECT_EQ(mock_pin_reads, 0);
+#else
+    // Every column except the NO_PIN one is read once per row
+    EXPECT_EQ(mock_port_reads, 0);
+    EXPECT_EQ(mock_pin_reads, (MATRIX_COLS - 1) * MATRIX_ROWS);
+#endif
+}
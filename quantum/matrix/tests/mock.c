@@ -0,0 +1,83 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "matrix.h"
+#include "mock.h"
+
+static bool pin_is_output[MOCK_PIN_COUNT];
+static bool pin_level[MOCK_PIN_COUNT];
+static bool switches[MOCK_PIN_COUNT][MOCK_PIN_COUNT];
+
+uint32_t mock_pin_reads  = 0;
+uint32_t mock_port_reads = 0;
+
+matrix_row_t raw_matrix[MATRIX_ROWS];
+matrix_row_t matrix[MATRIX_ROWS];
+
+void mock_reset(void) {
+    memset(pin_is_output, 0, sizeof(pin_is_output));
+    memset(pin_level, 0, sizeof(pin_level));
+    memset(switches, 0, sizeof(switches));
+    mock_pin_reads  = 0;
+    mock_port_reads = 0;
+}
+
+void mock_set_switch(pin_t output, pin_t input, bool closed) {
+    switches[output][input] = closed;
+}
+
+void mock_set_pin_input_high(pin_t pin) {
+    pin_is_output[pin] = false;
+    pin_level[pin]     = true;
+}
+
+void mock_set_pin_output(pin_t pin) {
+    pin_is_output[pin] = true;
+}
+
+void mock_write_pin(pin_t pin, bool level) {
+    pin_level[pin] = level;
+}
+
+static bool pin_level_of(pin_t pin) {
+    if (pin_is_output[pin]) {
+        return pin_level[pin];
+    }
+    // Inputs are pulled high unless a closed switch connects them to an output driven low
+    for (pin_t output = 0; output < MOCK_PIN_COUNT; output++) {
+        if (switches[output][pin] && pin_is_output[output] && !pin_level[output]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool mock_read_pin(pin_t pin) {
+    mock_pin_reads++;
+    return pin_level_of(pin);
+}
+
+gpio_port_state_t mock_read_port(gpio_port_t port) {
+    mock_port_reads++;
+    gpio_port_state_t state = 0;
+    for (uint8_t pad = 0; pad < MOCK_PADS_PER_PORT; pad++) {
+        if (pin_level_of(MOCK_PIN(port, pad))) {
+            state |= (gpio_port_state_t)1 << pad;
+        }
+    }
+    return state;
+}
+
+matrix_row_t matrix_get_row(uint8_t row) {
+    return matrix[row];
+}
+
+void matrix_init_kb(void) {}
+
+void matrix_scan_kb(void) {}
+
+void matrix_output_select_delay(void) {}
+
+void matrix_output_unselect_delay(uint8_t line, bool key_pressed) {}
+
@@ -0,0 +1,40 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Simulated GPIO with port registers: 4 ports of 16 pads each. */
+#define MOCK_PORT_COUNT 4
+#define MOCK_PADS_PER_PORT 16
+#define MOCK_PIN_COUNT (MOCK_PORT_COUNT * MOCK_PADS_PER_PORT)
+#define MOCK_PIN(port, pad) ((port)*MOCK_PADS_PER_PORT + (pad))
+
+typedef uint8_t  pin_t;
+typedef uint8_t  gpio_port_t;
+typedef uint16_t gpio_port_state_t;
+
+#define gpio_set_pin_input_high(pin) mock_set_pin_input_high(pin)
+#define gpio_set_pin_output(pin) mock_set_pin_output(pin)
+#define gpio_write_pin_high(pin) mock_write_pin(pin, true)
+#define gpio_write_pin_low(pin) mock_write_pin(pin, false)
+#define gpio_read_pin(pin) mock_read_pin(pin)
+
+#define gpio_pin_port(pin) ((gpio_port_t)((pin) / MOCK_PADS_PER_PORT))
+#define gpio_pin_pad(pin) ((pin) % MOCK_PADS_PER_PORT)
+#define gpio_read_port(port) mock_read_port(port)
+
+void              mock_set_pin_input_high(pin_t pin);
+void              mock_set_pin_output(pin_t pin);
+void              mock_write_pin(pin_t pin, bool level);
+bool              mock_read_pin(pin_t pin);
+gpio_port_state_t mock_read_port(gpio_port_t port);
+
+/* Closes or opens the switch connecting `output` to `input`. */
+void mock_set_switch(pin_t output, pin_t input, bool closed);
+void mock_reset(void);
+
+extern uint32_t mock_pin_reads;
+extern uint32_t mock_port_reads;
@@ -0,0 +1,18 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+MATRIX_COMMON_DEFS := -DIGNORE_ATOMIC_BLOCK
+
+MATRIX_COMMON_SRC := \
+	$(QUANTUM_PATH)/matrix/tests/mock.c \
+	$(QUANTUM_PATH)/matrix/tests/matrix_tests.cpp \
+	$(QUANTUM_PATH)/debounce/none.c \
+	$(QUANTUM_PATH)/matrix.c
+
+matrix_pin_DEFS := $(MATRIX_COMMON_DEFS)
+matrix_pin_CONFIG := $(QUANTUM_PATH)/matrix/tests/config_mock.h
+matrix_pin_SRC := $(MATRIX_COMMON_SRC)
+
+matrix_port_DEFS := $(MATRIX_COMMON_DEFS) -DMATRIX_READ_COLS_BY_PORT
+matrix_port_CONFIG := $(QUANTUM_PATH)/matrix/tests/config_mock.h
+matrix_port_SRC := $(MATRIX_COMMON_SRC)
@@ -0,0 +1,3 @@
+TEST_LIST += \
+	matrix_pin \
+	matrix_port
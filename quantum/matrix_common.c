@@ -3,6 +3,7 @@
 #include "wait.h"
 #include "print.h"
 #include "debug.h"
+#include "timer.h"
 
 #ifdef SPLIT_KEYBOARD
 #    include "split_common/split_util.h"
@@ -31,6 +32,12 @@ uint8_t thisHand, thatHand;
 extern const matrix_row_t matrix_mask[];
 #endif
 
+#ifdef MATRIX_FIRST_EDGE_TIME
+// time of the first scan at which each key's raw state differed from its debounced state
+static uint16_t     key_change_time[MATRIX_ROWS][MATRIX_COLS];
+static matrix_row_t key_change_pending[MATRIX_ROWS];
+#endif
+
 // user-defined overridable functions
 
 __attribute__((weak)) void matrix_init_kb(void) {
@@ -69,6 +76,36 @@ inline matrix_row_t matrix_get_row(uint8_t row) {
 #endif
 }
 
+#ifdef MATRIX_FIRST_EDGE_TIME
+/**
+ * Deferring debounce algorithms only push a change DEBOUNCE ms (or more, if the main loop is slow)
+ * after the switch moved. Remembering when the raw state first diverged lets the key event carry
+ * the time of the first edge instead of the time it got out of debounce.
+ */
+void matrix_update_key_times(uint8_t first_row, uint8_t num_rows) {
+    for (uint8_t i = 0; i < num_rows; i++) {
+        uint8_t      row       = first_row + i;
+        matrix_row_t diverged  = raw_matrix[i] ^ matrix[row];
+        matrix_row_t new_edges = diverged & ~key_change_pending[row];
+
+        // Keys that were already pending keep their time, even when debounce pushes others in the row
+        if (new_edges) {
+            uint16_t now = timer_read();
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                if (new_edges & (MATRIX_ROW_SHIFTER << col)) {
+                    key_change_time[row][col] = now;
+                }
+            }
+        }
+        key_change_pending[row] = diverged;
+    }
+}
+
+uint16_t matrix_get_key_time(uint8_t row, uint8_t col) {
+    return (key_change_pending[row] & (MATRIX_ROW_SHIFTER << col)) ? key_change_time[row][col] : timer_read();
+}
+#endif
+
 #if (MATRIX_COLS <= 8)
 #    define print_matrix_header() print("\nr/c 01234567\n")
 #    define print_matrix_row(row) print_bin_reverse8(matrix_get_row(row))
@@ -139,6 +176,13 @@ __attribute__((weak)) bool matrix_scan_custom(matrix_row_t current_matrix[]) {
     return true;
 }
 
+#ifdef MATRIX_IDLE_WAIT_ENABLE
+// Custom matrices can't arm their inputs as wakeup sources, so never block
+__attribute__((weak)) bool matrix_idle_wait(uint32_t timeout_ms) {
+    return false;
+}
+#endif
+
 #ifdef SPLIT_KEYBOARD
 __attribute__((weak)) void matrix_slave_scan_kb(void) {
     matrix_slave_scan_user();
@@ -169,10 +213,15 @@ __attribute__((weak)) uint8_t matrix_scan(void) {
     bool changed = matrix_scan_custom(raw_matrix);
 
 #ifdef SPLIT_KEYBOARD
+    matrix_update_key_times(thisHand, ROWS_PER_HAND);
     changed = debounce(raw_matrix, matrix + thisHand, ROWS_PER_HAND, changed) | matrix_post_scan();
 #else
+    matrix_update_key_times(0, ROWS_PER_HAND);
     changed = debounce(raw_matrix, matrix, ROWS_PER_HAND, changed);
+#    ifndef KEY_EVENT_QUEUE_ASYNC_SCAN
+    // Called from keyboard_task() instead, see KEY_EVENT_QUEUE_ASYNC_SCAN
     matrix_scan_kb();
+#    endif
 #endif
 
     return changed;
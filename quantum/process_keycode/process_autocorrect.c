@@ -19,6 +19,19 @@
 #    include "autocorrect_data_default.h"
 #endif
 
+#ifdef AUTOCORRECT_FLASH_OFFSET
+#    ifndef AUTOCORRECT_BITMAP_TRIE
+#        error "AUTOCORRECT_FLASH_OFFSET requires autocorrect data generated with --format bitmap"
+#    endif
+#    include "flash.h"
+// Corrections read from flash are copied to RAM
+#    define autocorrect_strcpy strcpy
+#    define autocorrect_send_string send_string
+#else
+#    define autocorrect_strcpy strcpy_P
+#    define autocorrect_send_string send_string_P
+#endif
+
 static uint8_t typo_buffer[AUTOCORRECT_MAX_LENGTH] = {KC_SPC};
 static uint8_t typo_buffer_size                    = 1;
 
@@ -188,6 +201,162 @@ __attribute__((weak)) bool apply_autocorrect(uint8_t backspaces, const char *str
     return true;
 }
 
+#ifdef AUTOCORRECT_BITMAP_TRIE
+#    define AUTOCORRECT_TRIE_MATCH (1UL << 31)
+
+#    ifdef AUTOCORRECT_FLASH_OFFSET
+#        define AUTOCORRECT_CORRECTIONS_OFFSET (AUTOCORRECT_FLASH_OFFSET + AUTOCORRECT_TRIE_NODES * 8UL)
+
+static char autocorrect_changes[AUTOCORRECT_MAX_CORRECTION_LENGTH + 1];
+#    endif
+
+/**
+ * @brief position of the bit for a keycode in the child bitmap of a trie node
+ */
+static inline uint8_t autocorrect_trie_bit(uint8_t keycode) {
+    switch (keycode) {
+        case KC_QUOTE:
+            return 26;
+        case KC_SPC:
+            return 27;
+        default:
+            return keycode - KC_A;
+    }
+}
+
+/**
+ * @brief reads the child bitmap and link of a trie node
+ *
+ * @param index node to read
+ * @param node receives the two words of the node
+ */
+static void autocorrect_read_node(uint32_t index, uint32_t node[2]) {
+#    ifdef AUTOCORRECT_FLASH_OFFSET
+    uint8_t buf[8];
+    if (flash_read_range(AUTOCORRECT_FLASH_OFFSET + index * sizeof(buf), buf, sizeof(buf)) != FLASH_STATUS_SUCCESS) {
+        // Treat an unreadable node as having no children, ending the lookup.
+        node[0] = 0;
+        return;
+    }
+    for (uint8_t i = 0; i < 2; ++i) {
+        node[i] = buf[i * 4] | (uint32_t)buf[i * 4 + 1] << 8 | (uint32_t)buf[i * 4 + 2] << 16 | (uint32_t)buf[i * 4 + 3] << 24;
+    }
+#    else
+    node[0] = pgm_read_dword(autocorrect_trie + index * 2);
+    node[1] = pgm_read_dword(autocorrect_trie + index * 2 + 1);
+#    endif
+}
+
+/**
+ * @brief reads an entry of the corrections table
+ *
+ * @param offset start of the entry
+ * @param backspaces receives the number of characters to remove
+ * @param changes receives the string to replace them with
+ * @return true if the entry could be read
+ */
+static bool autocorrect_read_correction(uint32_t offset, uint8_t *backspaces, const char **changes) {
+    if (offset >= AUTOCORRECT_CORRECTIONS_SIZE) {
+        return false;
+    }
+#    ifdef AUTOCORRECT_FLASH_OFFSET
+    uint32_t len = AUTOCORRECT_CORRECTIONS_SIZE - offset - 1;
+    if (len > AUTOCORRECT_MAX_CORRECTION_LENGTH) {
+        len = AUTOCORRECT_MAX_CORRECTION_LENGTH;
+    }
+    if (flash_read_range(AUTOCORRECT_CORRECTIONS_OFFSET + offset, backspaces, 1) != FLASH_STATUS_SUCCESS || flash_read_range(AUTOCORRECT_CORRECTIONS_OFFSET + offset + 1, autocorrect_changes, len) != FLASH_STATUS_SUCCESS) {
+        return false;
+    }
+    autocorrect_changes[len] = 0;
+    *changes                 = autocorrect_changes;
+#    else
+    *backspaces = pgm_read_byte(autocorrect_corrections + offset);
+    *changes    = (const char *)(autocorrect_corrections + offset + 1);
+#    endif
+    return true;
+}
+
+/**
+ * @brief looks for a typo at the end of the buffer
+ *
+ * Every node of the trie holds a bitmap of the characters it has children
+ * for, and the index of its first child. Children are stored in bitmap
+ * order, so the child for a character is found by counting the bits below
+ * it, and each character costs a single node read however large the
+ * dictionary is.
+ *
+ * @param backspaces receives the number of characters to remove
+ * @param changes receives the string to replace them with
+ * @return true if a typo was found
+ */
+static bool autocorrect_find(uint8_t *backspaces, const char **changes) {
+    uint32_t node[2];
+    autocorrect_read_node(0, node);
+    for (int8_t i = typo_buffer_size - 1; i >= 0; --i) {
+        uint32_t const bit = 1UL << autocorrect_trie_bit(typo_buffer[i]);
+        if (!(node[0] & bit)) {
+            return false;
+        }
+
+        uint32_t const index = node[1] + __builtin_popcountl(node[0] & (bit - 1));
+        // Safeguard in case of a bug, data corruption, etc.
+        if (index >= AUTOCORRECT_TRIE_NODES) {
+            return false;
+        }
+
+        autocorrect_read_node(index, node);
+        if (node[0] & AUTOCORRECT_TRIE_MATCH) {
+            return autocorrect_read_correction(node[1], backspaces, changes);
+        }
+    }
+    return false;
+}
+#else
+/**
+ * @brief looks for a typo at the end of the buffer, using the trie stored in `autocorrect_data`
+ *
+ * @param backspaces receives the number of characters to remove
+ * @param changes receives the PROGMEM string to replace them with
+ * @return true if a typo was found
+ */
+static bool autocorrect_find(uint8_t *backspaces, const char **changes) {
+    uint16_t state = 0;
+    uint8_t  code  = pgm_read_byte(autocorrect_data + state);
+    for (int8_t i = typo_buffer_size - 1; i >= 0; --i) {
+        uint8_t const key_i = typo_buffer[i];
+
+        if (code & 64) { // Check for match in node with multiple children.
+            code &= 63;
+            for (; code != key_i; code = pgm_read_byte(autocorrect_data + (state += 3))) {
+                if (!code) return false;
+            }
+            // Follow link to child node.
+            state = (pgm_read_byte(autocorrect_data + state + 1) | pgm_read_byte(autocorrect_data + state + 2) << 8);
+            // Check for match in node with single child.
+        } else if (code != key_i) {
+            return false;
+        } else if (!(code = pgm_read_byte(autocorrect_data + (++state)))) {
+            ++state;
+        }
+
+        // Stop if `state` becomes an invalid index. This should not normally
+        // happen, it is a safeguard in case of a bug, data corruption, etc.
+        if (state >= DICTIONARY_SIZE) {
+            return false;
+        }
+
+        code = pgm_read_byte(autocorrect_data + state);
+
+        if (code & 128) { // A typo was found!
+            *backspaces = code & 63;
+            *changes    = (const char *)(autocorrect_data + state + 1);
+            return true;
+        }
+    }
+    return false;
+}
+#endif
+
 /**
  * @brief Process handler for autocorrect feature
  *
@@ -278,98 +447,72 @@ bool process_autocorrect(uint16_t keycode, keyrecord_t *record) {
         return true;
     }
 
-    // Check for typo in buffer using a trie stored in `autocorrect_data`.
-    uint16_t state = 0;
-    uint8_t  code  = pgm_read_byte(autocorrect_data + state);
-    for (int8_t i = typo_buffer_size - 1; i >= 0; --i) {
-        uint8_t const key_i = typo_buffer[i];
-
-        if (code & 64) { // Check for match in node with multiple children.
-            code &= 63;
-            for (; code != key_i; code = pgm_read_byte(autocorrect_data + (state += 3))) {
-                if (!code) return true;
-            }
-            // Follow link to child node.
-            state = (pgm_read_byte(autocorrect_data + state + 1) | pgm_read_byte(autocorrect_data + state + 2) << 8);
-            // Check for match in node with single child.
-        } else if (code != key_i) {
-            return true;
-        } else if (!(code = pgm_read_byte(autocorrect_data + (++state)))) {
-            ++state;
-        }
-
-        // Stop if `state` becomes an invalid index. This should not normally
-        // happen, it is a safeguard in case of a bug, data corruption, etc.
-        if (state >= DICTIONARY_SIZE) {
-            return true;
+    // Check for typo in buffer using the trie.
+    uint8_t     backspaces;
+    const char *changes;
+    if (!autocorrect_find(&backspaces, &changes)) {
+        return true;
+    }
+    // A typo was found! Apply autocorrect.
+    backspaces += !record->event.pressed;
+
+    /* Gather info about the typo'd word
+     *
+     * Since buffer may contain several words, delimited by spaces, we
+     * iterate from the end to find the start and length of the typo
+     */
+    char typo[AUTOCORRECT_MAX_LENGTH + 1] = {0}; // extra char for null terminator
+
+    uint8_t typo_len   = 0;
+    uint8_t typo_start = 0;
+    bool    space_last = typo_buffer[typo_buffer_size - 1] == KC_SPC;
+    for (uint8_t i = typo_buffer_size; i > 0; --i) {
+        // stop counting after finding space (unless it is the last thing)
+        if (typo_buffer[i - 1] == KC_SPC && i != typo_buffer_size) {
+            typo_start = i;
+            break;
         }
 
-        code = pgm_read_byte(autocorrect_data + state);
-
-        if (code & 128) { // A typo was found! Apply autocorrect.
-            const uint8_t backspaces = (code & 63) + !record->event.pressed;
-            const char *  changes    = (const char *)(autocorrect_data + state + 1);
-
-            /* Gather info about the typo'd word
-             *
-             * Since buffer may contain several words, delimited by spaces, we
-             * iterate from the end to find the start and length of the typo
-             */
-            char typo[AUTOCORRECT_MAX_LENGTH + 1] = {0}; // extra char for null terminator
-
-            uint8_t typo_len   = 0;
-            uint8_t typo_start = 0;
-            bool    space_last = typo_buffer[typo_buffer_size - 1] == KC_SPC;
-            for (uint8_t i = typo_buffer_size; i > 0; --i) {
-                // stop counting after finding space (unless it is the last thing)
-                if (typo_buffer[i - 1] == KC_SPC && i != typo_buffer_size) {
-                    typo_start = i;
-                    break;
-                }
-
-                ++typo_len;
-            }
-
-            // when detecting 'typo:', reduce the length of the string by one
-            if (space_last) {
-                --typo_len;
-            }
+        ++typo_len;
+    }
 
-            // convert buffer of keycodes into a string
-            for (uint8_t i = 0; i < typo_len; ++i) {
-                typo[i] = typo_buffer[typo_start + i] - KC_A + 'a';
-            }
+    // when detecting 'typo:', reduce the length of the string by one
+    if (space_last) {
+        --typo_len;
+    }
 
-            /* Gather the corrected word
-             *
-             * A) Correction of 'typo:' -- Code takes into account
-             * an extra backspace to delete the space (which we dont copy)
-             * for this reason the offset is correct to "skip" the null terminator
-             *
-             * B) When correcting 'typo' -- Need extra offset for terminator
-             */
-            char correct[AUTOCORRECT_MAX_LENGTH + 10] = {0}; // let's hope this is big enough
-
-            uint8_t offset = space_last ? backspaces : backspaces + 1;
-            strcpy(correct, typo);
-            strcpy_P(correct + typo_len - offset, changes);
-
-            if (apply_autocorrect(backspaces, changes, typo, correct)) {
-                for (uint8_t i = 0; i < backspaces; ++i) {
-                    tap_code(KC_BSPC);
-                }
-                send_string_P(changes);
-            }
+    // convert buffer of keycodes into a string
+    for (uint8_t i = 0; i < typo_len; ++i) {
+        typo[i] = typo_buffer[typo_start + i] - KC_A + 'a';
+    }
 
-            if (keycode == KC_SPC) {
-                typo_buffer[0]   = KC_SPC;
-                typo_buffer_size = 1;
-                return true;
-            } else {
-                typo_buffer_size = 0;
-                return false;
-            }
+    /* Gather the corrected word
+     *
+     * A) Correction of 'typo:' -- Code takes into account
+     * an extra backspace to delete the space (which we dont copy)
+     * for this reason the offset is correct to "skip" the null terminator
+     *
+     * B) When correcting 'typo' -- Need extra offset for terminator
+     */
+    char correct[AUTOCORRECT_MAX_LENGTH + 10] = {0}; // let's hope this is big enough
+
+    uint8_t offset = space_last ? backspaces : backspaces + 1;
+    strcpy(correct, typo);
+    autocorrect_strcpy(correct + typo_len - offset, changes);
+
+    if (apply_autocorrect(backspaces, changes, typo, correct)) {
+        for (uint8_t i = 0; i < backspaces; ++i) {
+            tap_code(KC_BSPC);
         }
+        autocorrect_send_string(changes);
+    }
+
+    if (keycode == KC_SPC) {
+        typo_buffer[0]   = KC_SPC;
+        typo_buffer_size = 1;
+        return true;
+    } else {
+        typo_buffer_size = 0;
+        return false;
     }
-    return true;
 }
@@ -16,6 +16,7 @@
 
 #include "process_combo.h"
 #include <stddef.h>
+#include <string.h>
 #include "process_auto_shift.h"
 #include "caps_word.h"
 #include "timer.h"
@@ -26,6 +27,10 @@
 #include "action_tapping.h"
 #include "action_util.h"
 #include "keymap_introspection.h"
+#include "debug.h"
+#ifdef COMBO_KEY_INDEX
+#    include "sorted_index.h"
+#endif
 
 __attribute__((weak)) void process_combo_event(uint16_t combo_index, bool pressed) {}
 
@@ -94,6 +99,26 @@ static queued_combo_t combo_buffer[COMBO_BUFFER_LENGTH];
 
 #define INCREMENT_MOD(i) i = (i + 1) % COMBO_BUFFER_LENGTH
 
+#ifdef COMBO_KEY_INDEX
+/* One entry per distinct key of each combo, carrying what process_combo_key()
+ * would otherwise work out by walking the combo's keys. */
+typedef struct {
+    uint16_t keycode;
+    uint16_t combo_index;
+    uint8_t  key_index;
+    uint8_t  key_count;
+} combo_key_t;
+static combo_key_t combo_keys[COMBO_KEY_INDEX_SIZE];
+static uint16_t    combo_keys_size = 0;
+
+static sorted_index_state_t combo_key_index_state = SORTED_INDEX_INVALID;
+
+/* Combos whose state may need to be cleared */
+static uint8_t combo_touched[(COMBO_KEY_INDEX_SIZE + 7) / 8];
+
+#    define COMBO_TOUCH(combo_index) (combo_touched[(combo_index) / 8] |= 1 << ((combo_index) % 8))
+#endif
+
 #ifndef EXTRA_SHORT_COMBOS
 /* flags are their own elements in combo_t struct. */
 #    define COMBO_ACTIVE(combo) (combo->active)
@@ -194,6 +219,23 @@ static inline uint16_t _get_combo_term(uint16_t combo_index, combo_t *combo) {
 void clear_combos(void) {
     uint16_t index = 0;
     longest_term   = 0;
+#ifdef COMBO_KEY_INDEX
+    if (combo_key_index_state == SORTED_INDEX_VALID) {
+        for (uint16_t i = 0; i < sizeof(combo_touched); ++i) {
+            for (uint8_t bit = 0; combo_touched[i] >> bit; ++bit) {
+                if (!(combo_touched[i] & (1 << bit))) {
+                    continue;
+                }
+                combo_t *combo = combo_get(i * 8 + bit);
+                if (!COMBO_ACTIVE(combo)) {
+                    RESET_COMBO_STATE(combo);
+                    combo_touched[i] &= ~(1 << bit);
+                }
+            }
+        }
+        return;
+    }
+#endif
     for (index = 0; index < combo_count(); ++index) {
         combo_t *combo = combo_get(index);
         if (!COMBO_ACTIVE(combo)) {
@@ -278,6 +320,66 @@ static inline void _find_key_index_and_count(const uint16_t *keys, uint16_t keyc
     }
 }
 
+#ifdef COMBO_KEY_INDEX
+static int combo_key_compare(const void *a, const void *b) {
+    uint16_t keycode_a = ((const combo_key_t *)a)->keycode;
+    uint16_t keycode_b = ((const combo_key_t *)b)->keycode;
+    return keycode_a < keycode_b ? -1 : keycode_a > keycode_b;
+}
+
+void combo_key_index_rebuild(void) {
+    uint16_t count  = combo_count();
+    combo_keys_size = 0;
+
+    // Combo indices also need to fit into combo_touched
+    if (count > COMBO_KEY_INDEX_SIZE) {
+        goto overflow;
+    }
+
+    for (uint16_t combo_index = 0; combo_index < count; ++combo_index) {
+        const uint16_t *keys = combo_get(combo_index)->keys;
+        uint8_t         key_count;
+        for (key_count = 0; pgm_read_word(&keys[key_count]) != COMBO_END; ++key_count) {
+        }
+
+        for (uint8_t key_index = 0; key_index < key_count; ++key_index) {
+            uint16_t key = pgm_read_word(&keys[key_index]);
+            // A key listed twice only counts at its last position, like _find_key_index_and_count()
+            uint8_t later;
+            for (later = key_index + 1; later < key_count && pgm_read_word(&keys[later]) != key; ++later) {
+            }
+            if (later < key_count) {
+                continue;
+            }
+            if (combo_keys_size == COMBO_KEY_INDEX_SIZE) {
+                goto overflow;
+            }
+            // Combos of the same key stay in index order
+            combo_key_t entry = {.keycode = key, .combo_index = combo_index, .key_index = key_index, .key_count = key_count};
+            sorted_index_insert(combo_keys, &combo_keys_size, sizeof(combo_key_t), &entry, combo_key_compare);
+        }
+    }
+
+    // Combo indices may have changed, let the next clear_combos() look at all of them
+    memset(combo_touched, 0, sizeof(combo_touched));
+    for (uint16_t combo_index = 0; combo_index < count; ++combo_index) {
+        COMBO_TOUCH(combo_index);
+    }
+    combo_key_index_state = SORTED_INDEX_VALID;
+    return;
+
+overflow:
+    sorted_index_print_overflow("combo", count, "combos", COMBO_KEY_INDEX_SIZE);
+    combo_key_index_state = SORTED_INDEX_OVERFLOW;
+}
+
+/* Returns the position of the first combo key with the given keycode */
+static uint16_t combo_key_index_find(uint16_t keycode) {
+    combo_key_t key = {.keycode = keycode};
+    return sorted_index_lower_bound(combo_keys, 0, combo_keys_size, sizeof(combo_key_t), &key, combo_key_compare);
+}
+#endif
+
 void drop_combo_from_buffer(uint16_t combo_index) {
     /* Mark a combo as processed from the buffer. If the buffer is in the
      * beginning of the buffer, drop it.  */
@@ -414,16 +516,7 @@ static bool keys_pressed_in_order(uint16_t combo_index, combo_t *combo, uint16_t
 }
 #endif
 
-static bool process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *record, uint16_t combo_index) {
-    uint8_t  key_count = 0;
-    uint16_t key_index = -1;
-    _find_key_index_and_count(combo->keys, keycode, &key_index, &key_count);
-
-    /* Continue processing if key isn't part of current combo. */
-    if (-1 == (int16_t)key_index) {
-        return false;
-    }
-
+static bool process_combo_key(combo_t *combo, uint16_t keycode, keyrecord_t *record, uint16_t combo_index, uint16_t key_index, uint8_t key_count) {
     bool key_is_part_of_combo = (!COMBO_DISABLED(combo) && is_combo_enabled()
 #if defined(COMBO_MUST_PRESS_IN_ORDER) || defined(COMBO_MUST_PRESS_IN_ORDER_PER_COMBO)
                                  && keys_pressed_in_order(combo_index, combo, key_index, keycode, record)
@@ -534,6 +627,19 @@ static bool process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *
     return key_is_part_of_combo;
 }
 
+static bool process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *record, uint16_t combo_index) {
+    uint8_t  key_count = 0;
+    uint16_t key_index = -1;
+    _find_key_index_and_count(combo->keys, keycode, &key_index, &key_count);
+
+    /* Continue processing if key isn't part of current combo. */
+    if (-1 == (int16_t)key_index) {
+        return false;
+    }
+
+    return process_combo_key(combo, keycode, record, combo_index, key_index, key_count);
+}
+
 bool process_combo(uint16_t keycode, keyrecord_t *record) {
     bool is_combo_key          = false;
     bool no_combo_keys_pressed = true;
@@ -564,10 +670,21 @@ bool process_combo(uint16_t keycode, keyrecord_t *record) {
     }
 #endif
 
-    for (uint16_t idx = 0; idx < combo_count(); ++idx) {
-        combo_t *combo = combo_get(idx);
-        is_combo_key |= process_single_combo(combo, keycode, record, idx);
-        no_combo_keys_pressed = no_combo_keys_pressed && (NO_COMBO_KEYS_ARE_DOWN || COMBO_ACTIVE(combo) || COMBO_DISABLED(combo));
+#ifdef COMBO_KEY_INDEX
+    if (combo_key_index_state == SORTED_INDEX_VALID) {
+        for (uint16_t i = combo_key_index_find(keycode); i < combo_keys_size && combo_keys[i].keycode == keycode; ++i) {
+            const combo_key_t *entry = &combo_keys[i];
+            COMBO_TOUCH(entry->combo_index);
+            is_combo_key |= process_combo_key(combo_get(entry->combo_index), keycode, record, entry->combo_index, entry->key_index, entry->key_count);
+        }
+    } else
+#endif
+    {
+        for (uint16_t idx = 0; idx < combo_count(); ++idx) {
+            combo_t *combo = combo_get(idx);
+            is_combo_key |= process_single_combo(combo, keycode, record, idx);
+            no_combo_keys_pressed = no_combo_keys_pressed && (NO_COMBO_KEYS_ARE_DOWN || COMBO_ACTIVE(combo) || COMBO_DISABLED(combo));
+        }
     }
 
     if (record->event.pressed && is_combo_key) {
@@ -38,6 +38,9 @@
 #ifndef COMBO_BUFFER_LENGTH
 #    define COMBO_BUFFER_LENGTH 4
 #endif
+#if defined(COMBO_KEY_INDEX) && !defined(COMBO_KEY_INDEX_SIZE)
+#    define COMBO_KEY_INDEX_SIZE 256
+#endif
 
 typedef struct combo_t {
     const uint16_t *keys;
@@ -81,3 +84,10 @@ void combo_enable(void);
 void combo_disable(void);
 void combo_toggle(void);
 bool is_combo_enabled(void);
+
+#ifdef COMBO_KEY_INDEX
+/** Sorts the combo keys into the index, which keyboard_init() does once. Call this again whenever combo_count() or combo_get() start returning different combos. */
+void combo_key_index_rebuild(void);
+#else
+#    define combo_key_index_rebuild()
+#endif
@@ -22,6 +22,10 @@
 #include "action.h"
 #include "action_layer.h"
 
+#if defined(KEY_OVERRIDE_INDEX) && !defined(KEY_OVERRIDE_INDEX_SIZE)
+#    define KEY_OVERRIDE_INDEX_SIZE 256
+#endif
+
 /**
  * Key overrides allow you to send a different key-modifier combination or perform a custom action when a certain modifier-key combination is pressed.
  *
@@ -105,6 +109,13 @@ bool process_key_override(const uint16_t keycode, const keyrecord_t *const recor
 /** Perform any deferred keys */
 void key_override_task(void);
 
+#ifdef KEY_OVERRIDE_INDEX
+/** Sorts the overrides into the trigger index, which keyboard_init() does once. Call this again whenever key_override_count() or key_override_get() start returning different overrides. */
+void key_override_index_rebuild(void);
+#else
+#    define key_override_index_rebuild()
+#endif
+
 /**
  *  Preferrably use these macros to create key overrides. They fix many of the options to a standard setting that should satisfy most basic use-cases. Only directly create a key_override_t struct when you really need to.
  */
@@ -35,6 +35,15 @@ bool process_leader(uint16_t keycode, keyrecord_t *record) {
                 return true;
             }
 
+#ifdef LEADER_SEQUENCES_ENABLE
+            // No need to wait for more keys once only one sequence can match
+            if (leader_sequence_complete()) {
+                leader_end();
+
+                return false;
+            }
+#endif
+
 #ifdef LEADER_PER_KEY_TIMING
             leader_reset_timer();
 #endif
@@ -47,15 +47,76 @@ static inline void steno_clear_chord(void) {
     memset(chord, 0, sizeof(chord));
 }
 
+#ifdef STENO_OUTPUT_QUEUE
+#    ifndef VIRTSER_ENABLE
+#        error "STENO_OUTPUT_QUEUE requires VIRTSER_ENABLE = yes"
+#    endif
+
+#    define STENO_OUTPUT_QUEUE_MASK (STENO_OUTPUT_QUEUE_SIZE - 1)
+
+// Encoded packets, each preceded by its length
+static uint8_t output_queue[STENO_OUTPUT_QUEUE_SIZE];
+// Free running indices; both sides run in the main loop, so no locking is needed
+static uint8_t output_head = 0;
+static uint8_t output_tail = 0;
+
+static bool steno_output_queue_push(const uint8_t *packet, uint8_t size) {
+    uint8_t head = output_head;
+
+    if ((uint8_t)(head - output_tail) + 1 + size > STENO_OUTPUT_QUEUE_SIZE) {
+        return false;
+    }
+
+    output_queue[head & STENO_OUTPUT_QUEUE_MASK] = size;
+    for (uint8_t i = 0; i < size; ++i) {
+        output_queue[(uint8_t)(head + 1 + i) & STENO_OUTPUT_QUEUE_MASK] = packet[i];
+    }
+    output_head = head + 1 + size;
+    return true;
+}
+
+bool steno_output_queue_task(void) {
+    uint8_t tail = output_tail;
+
+    if (output_head == tail) {
+        return false;
+    }
+
+    uint8_t size = output_queue[tail & STENO_OUTPUT_QUEUE_MASK];
+    for (uint8_t i = 0; i < size; ++i) {
+        virtser_send(output_queue[(uint8_t)(tail + 1 + i) & STENO_OUTPUT_QUEUE_MASK]);
+    }
+    output_tail = tail + 1 + size;
+    return true;
+}
+
+uint8_t steno_output_queue_pending(void) {
+    return (uint8_t)(output_head - output_tail);
+}
+#endif // STENO_OUTPUT_QUEUE
+
+#ifdef VIRTSER_ENABLE
+static void send_steno_packet(const uint8_t *packet, uint8_t size) {
+#    ifdef STENO_OUTPUT_QUEUE
+    while (!steno_output_queue_push(packet, size)) {
+        // Rather than dropping the stroke, hand the oldest packet over right away
+        steno_output_queue_task();
+    }
+#    else
+    for (uint8_t i = 0; i < size; ++i) {
+        virtser_send(packet[i]);
+    }
+#    endif
+}
+#endif // VIRTSER_ENABLE
+
 #ifdef STENO_ENABLE_GEMINI
 
 #    ifdef VIRTSER_ENABLE
 void send_steno_chord_gemini(void) {
     // Set MSB to 1 to indicate the start of packet
     chord[0] |= 0x80;
-    for (uint8_t i = 0; i < GEMINI_STROKE_SIZE; ++i) {
-        virtser_send(chord[i]);
-    }
+    send_steno_packet(chord, GEMINI_STROKE_SIZE);
 }
 #    else
 #        pragma message "VIRTSER_ENABLE = yes is required for Gemini PR to work properly out of the box!"
@@ -93,18 +154,21 @@ static const uint8_t boltmap[64] PROGMEM = {TXB_NUL, TXB_NUM, TXB_NUM, TXB_NUM,
 
 #    ifdef VIRTSER_ENABLE
 static void send_steno_chord_bolt(void) {
+    uint8_t packet[BOLT_STROKE_SIZE + 1];
+    uint8_t size = 0;
     for (uint8_t i = 0; i < BOLT_STROKE_SIZE; ++i) {
         // TX Bolt uses variable length packets where each byte corresponds to a bit array of certain keys.
         // If a user chorded the keys of the first group with keys of the last group, for example, there
         // would be bytes of 0x00 in `chord` for the middle groups which we mustn't send.
         if (chord[i]) {
-            virtser_send(chord[i]);
+            packet[size++] = chord[i];
         }
     }
     // Sending a null packet is not always necessary, but it is simpler and more reliable
     // to unconditionally send it every time instead of keeping track of more states and
     // creating more branches in the execution of the program.
-    virtser_send(0);
+    packet[size++] = 0;
+    send_steno_packet(packet, size);
 }
 #    else
 #        pragma message "VIRTSER_ENABLE = yes is required for TX Bolt to work properly out of the box!"
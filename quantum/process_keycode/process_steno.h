@@ -30,6 +30,15 @@
 #    define MAX_STROKE_SIZE BOLT_STROKE_SIZE
 #endif
 
+#ifdef STENO_OUTPUT_QUEUE
+#    ifndef STENO_OUTPUT_QUEUE_SIZE
+#        define STENO_OUTPUT_QUEUE_SIZE 64
+#    endif
+#    if (STENO_OUTPUT_QUEUE_SIZE & (STENO_OUTPUT_QUEUE_SIZE - 1)) != 0 || STENO_OUTPUT_QUEUE_SIZE > 128
+#        error STENO_OUTPUT_QUEUE_SIZE must be a power of two, at most 128
+#    endif
+#endif
+
 typedef enum {
     STENO_MODE_GEMINI,
     STENO_MODE_BOLT,
@@ -40,3 +49,18 @@ bool process_steno(uint16_t keycode, keyrecord_t *record);
 void steno_init(void);
 void steno_set_mode(steno_mode_t mode);
 #endif // STENO_ENABLE_ALL
+
+#ifdef STENO_OUTPUT_QUEUE
+/**
+ * @brief Sends the oldest queued packet over the virtual serial port. Called
+ * once per main loop pass, and blocks for as long as virtser_send() does.
+ *
+ * @return false if nothing was queued
+ */
+bool steno_output_queue_task(void);
+
+/**
+ * @brief Returns the number of queued bytes, including a length byte per packet.
+ */
+uint8_t steno_output_queue_pending(void);
+#endif // STENO_OUTPUT_QUEUE
@@ -178,6 +178,10 @@ __attribute__((weak)) void post_process_record_user(uint16_t keycode, keyrecord_
 
 void shutdown_quantum(bool jump_to_bootloader) {
     clear_keyboard();
+#ifdef HOST_REPORT_QUEUE_ENABLE
+    // Release every key on the host before going away
+    host_report_queue_flush();
+#endif
 #if defined(MIDI_ENABLE) && defined(MIDI_BASIC)
     process_midi_all_notes_off();
 #endif
@@ -198,6 +202,9 @@ void shutdown_quantum(bool jump_to_bootloader) {
 #ifdef HAPTIC_ENABLE
     haptic_shutdown();
 #endif
+#if defined(DYNAMIC_KEYMAP_ENABLE) && defined(DYNAMIC_KEYMAP_RAM_SHADOW)
+    dynamic_keymap_flush();
+#endif
 }
 
 void reset_keyboard(void) {
@@ -260,143 +267,247 @@ void post_process_record_quantum(keyrecord_t *record) {
     post_process_record_kb(keycode, record);
 }
 
-/* Core keycode function, hands off handling to other functions,
-    then processes internal quantum keycodes, and then processes
-    ACTIONs.                                                      */
-bool process_record_quantum(keyrecord_t *record) {
-    uint16_t keycode = get_record_keycode(record, true);
-
-    // This is how you use actions here
-    // if (keycode == QK_LEADER) {
-    //   action_t action;
-    //   action.code = ACTION_DEFAULT_LAYER_SET(0);
-    //   process_action(record, action);
-    //   return false;
-    // }
-
-#if defined(SECURE_ENABLE)
-    if (!preprocess_secure(keycode, record)) {
-        return false;
-    }
+#if defined(RGBLIGHT_ENABLE) || defined(RGB_MATRIX_ENABLE)
+static bool process_rgb_route(uint16_t keycode, keyrecord_t *record) {
+    return process_rgb(keycode, record);
+}
 #endif
 
-#ifdef TAP_DANCE_ENABLE
-    if (preprocess_tap_dance(keycode, record)) {
-        // The tap dance might have updated the layer state, therefore the
-        // result of the keycode lookup might change.
-        keycode = get_record_keycode(record, true);
-    }
+#ifdef KEY_OVERRIDE_ENABLE
+static bool process_key_override_route(uint16_t keycode, keyrecord_t *record) {
+    return process_key_override(keycode, record);
+}
 #endif
 
-#ifdef RGBLIGHT_ENABLE
-    if (record->event.pressed) {
-        preprocess_rgblight();
-    }
-#endif
+typedef struct {
+    bool (*handler)(uint16_t keycode, keyrecord_t *record);
+    uint16_t first;
+    uint16_t last;
+} process_record_route_t;
 
-#ifdef WPM_ENABLE
-    if (record->event.pressed) {
-        update_wpm(keycode);
-    }
-#endif
+/* Handlers that observe every key, and handlers that only ever act on their
+ * own keycode range and pass anything else along untouched. The latter are
+ * skipped without being called for keycodes outside their range. The order
+ * is the order in which the handlers get to process a key.                 */
+#define ROUTE_ALL(handler) {handler, 0x0000, 0xFFFF}
+#define ROUTE_RANGE(handler, first, last) {handler, first, last}
 
-    if (!(
-#if defined(KEY_LOCK_ENABLE)
-            // Must run first to be able to mask key_up events.
-            process_key_lock(&keycode, record) &&
-#endif
+// clang-format off
+static const process_record_route_t process_record_routes[] = {
 #if defined(DYNAMIC_MACRO_ENABLE) && !defined(DYNAMIC_MACRO_USER_CALL)
-            // Must run asap to ensure all keypresses are recorded.
-            process_dynamic_macro(keycode, record) &&
+    // Must run asap to ensure all keypresses are recorded.
+    ROUTE_ALL(process_dynamic_macro),
 #endif
 #ifdef REPEAT_KEY_ENABLE
-            process_last_key(keycode, record) && process_repeat_key(keycode, record) &&
+    ROUTE_ALL(process_last_key),
+    ROUTE_ALL(process_repeat_key),
 #endif
 #if defined(AUDIO_ENABLE) && defined(AUDIO_CLICKY)
-            process_clicky(keycode, record) &&
+    ROUTE_ALL(process_clicky),
 #endif
 #ifdef HAPTIC_ENABLE
-            process_haptic(keycode, record) &&
+    ROUTE_ALL(process_haptic),
 #endif
 #if defined(VIA_ENABLE)
-            process_record_via(keycode, record) &&
+    ROUTE_RANGE(process_record_via, QK_MACRO, QK_MACRO_MAX),
 #endif
 #if defined(POINTING_DEVICE_ENABLE) && defined(POINTING_DEVICE_AUTO_MOUSE_ENABLE)
-            process_auto_mouse(keycode, record) &&
+    ROUTE_ALL(process_auto_mouse),
 #endif
-            process_record_kb(keycode, record) &&
+    ROUTE_ALL(process_record_kb),
 #if defined(SECURE_ENABLE)
-            process_secure(keycode, record) &&
+    ROUTE_RANGE(process_secure, QK_SECURE_LOCK, QK_SECURE_REQUEST),
 #endif
 #if defined(SEQUENCER_ENABLE)
-            process_sequencer(keycode, record) &&
+    ROUTE_RANGE(process_sequencer, QK_SEQUENCER, QK_SEQUENCER_MAX),
 #endif
 #if defined(MIDI_ENABLE) && defined(MIDI_ADVANCED)
-            process_midi(keycode, record) &&
+    ROUTE_RANGE(process_midi, QK_MIDI, QK_MIDI_MAX),
 #endif
 #ifdef AUDIO_ENABLE
-            process_audio(keycode, record) &&
+    ROUTE_RANGE(process_audio, QK_AUDIO, QK_AUDIO_MAX),
 #endif
 #if defined(BACKLIGHT_ENABLE)
-            process_backlight(keycode, record) &&
+    ROUTE_RANGE(process_backlight, QK_LIGHTING, QK_LIGHTING_MAX),
 #endif
 #if defined(LED_MATRIX_ENABLE)
-            process_led_matrix(keycode, record) &&
+    ROUTE_RANGE(process_led_matrix, QK_LIGHTING, QK_LIGHTING_MAX),
 #endif
 #ifdef STENO_ENABLE
-            process_steno(keycode, record) &&
+    ROUTE_RANGE(process_steno, QK_STENO, QK_STENO_MAX),
 #endif
 #if (defined(AUDIO_ENABLE) || (defined(MIDI_ENABLE) && defined(MIDI_BASIC))) && !defined(NO_MUSIC_MODE)
-            process_music(keycode, record) &&
+    ROUTE_ALL(process_music),
 #endif
 #ifdef CAPS_WORD_ENABLE
-            process_caps_word(keycode, record) &&
+    ROUTE_ALL(process_caps_word),
 #endif
 #ifdef KEY_OVERRIDE_ENABLE
-            process_key_override(keycode, record) &&
+    ROUTE_ALL(process_key_override_route),
 #endif
 #ifdef TAP_DANCE_ENABLE
-            process_tap_dance(keycode, record) &&
+    ROUTE_RANGE(process_tap_dance, QK_TAP_DANCE, QK_TAP_DANCE_MAX),
 #endif
 #if defined(UNICODE_COMMON_ENABLE)
-            process_unicode_common(keycode, record) &&
+    ROUTE_ALL(process_unicode_common),
 #endif
 #ifdef LEADER_ENABLE
-            process_leader(keycode, record) &&
+    ROUTE_ALL(process_leader),
 #endif
 #ifdef AUTO_SHIFT_ENABLE
-            process_auto_shift(keycode, record) &&
+    ROUTE_ALL(process_auto_shift),
 #endif
 #ifdef DYNAMIC_TAPPING_TERM_ENABLE
-            process_dynamic_tapping_term(keycode, record) &&
+    ROUTE_RANGE(process_dynamic_tapping_term, QK_DYNAMIC_TAPPING_TERM_PRINT, QK_DYNAMIC_TAPPING_TERM_DOWN),
 #endif
 #ifdef SPACE_CADET_ENABLE
-            process_space_cadet(keycode, record) &&
+    ROUTE_ALL(process_space_cadet),
 #endif
 #ifdef MAGIC_ENABLE
-            process_magic(keycode, record) &&
+    ROUTE_RANGE(process_magic, QK_MAGIC, QK_MAGIC_MAX),
 #endif
 #ifdef GRAVE_ESC_ENABLE
-            process_grave_esc(keycode, record) &&
+    ROUTE_RANGE(process_grave_esc, QK_GRAVE_ESCAPE, QK_GRAVE_ESCAPE),
 #endif
 #if defined(RGBLIGHT_ENABLE) || defined(RGB_MATRIX_ENABLE)
-            process_rgb(keycode, record) &&
+    ROUTE_RANGE(process_rgb_route, QK_LIGHTING, QK_LIGHTING_MAX),
 #endif
 #ifdef JOYSTICK_ENABLE
-            process_joystick(keycode, record) &&
+    ROUTE_RANGE(process_joystick, QK_JOYSTICK, QK_JOYSTICK_MAX),
 #endif
 #ifdef PROGRAMMABLE_BUTTON_ENABLE
-            process_programmable_button(keycode, record) &&
+    ROUTE_RANGE(process_programmable_button, QK_PROGRAMMABLE_BUTTON, QK_PROGRAMMABLE_BUTTON_MAX),
 #endif
 #ifdef AUTOCORRECT_ENABLE
-            process_autocorrect(keycode, record) &&
+    ROUTE_ALL(process_autocorrect),
 #endif
 #ifdef TRI_LAYER_ENABLE
-            process_tri_layer(keycode, record) &&
+    ROUTE_RANGE(process_tri_layer, QK_TRI_LAYER_LOWER, QK_TRI_LAYER_UPPER),
+#endif
+};
+// clang-format on
+
+#define PROCESS_RECORD_ROUTE_COUNT ARRAY_SIZE(process_record_routes)
+_Static_assert(PROCESS_RECORD_ROUTE_COUNT <= 64, "process_record_routes[] has more entries than a route mask can hold");
+
+/* The keycode space cut into segments at every route's first and last + 1,
+ * each with a mask of the routes (bit n for process_record_routes[n]) that
+ * cover it. Built by process_record_routes_init(), which keyboard_init()
+ * calls, at a cost of about 20 bytes of RAM per route entry.              */
+static uint16_t process_record_segment_first[2 * PROCESS_RECORD_ROUTE_COUNT + 1];
+static uint64_t process_record_segment_routes[2 * PROCESS_RECORD_ROUTE_COUNT + 1];
+static uint8_t  process_record_segment_count = 0;
+
+static void process_record_segment_add(uint16_t first) {
+    uint8_t pos = process_record_segment_count;
+    while (pos > 0 && process_record_segment_first[pos - 1] >= first) {
+        if (process_record_segment_first[--pos] == first) {
+            return;
+        }
+    }
+    memmove(&process_record_segment_first[pos + 1], &process_record_segment_first[pos], (process_record_segment_count - pos) * sizeof(process_record_segment_first[0]));
+    process_record_segment_first[pos] = first;
+    process_record_segment_count++;
+}
+
+void process_record_routes_init(void) {
+    process_record_segment_count = 0;
+    process_record_segment_add(0x0000);
+    for (uint8_t i = 0; i < PROCESS_RECORD_ROUTE_COUNT; i++) {
+        process_record_segment_add(process_record_routes[i].first);
+        if (process_record_routes[i].last < 0xFFFF) {
+            process_record_segment_add(process_record_routes[i].last + 1);
+        }
+    }
+
+    for (uint8_t segment = 0; segment < process_record_segment_count; segment++) {
+        uint16_t first = process_record_segment_first[segment];
+        uint64_t mask  = 0;
+        for (uint8_t i = 0; i < PROCESS_RECORD_ROUTE_COUNT; i++) {
+            if (first >= process_record_routes[i].first && first <= process_record_routes[i].last) {
+                mask |= (uint64_t)1 << i;
+            }
+        }
+        process_record_segment_routes[segment] = mask;
+    }
+}
+
+/* Returns the mask of routes that cover `keycode`, or of every route if the
+ * segments have not been built yet, in which case each route checks its own
+ * range.                                                                    */
+static uint64_t process_record_routes_for(uint16_t keycode) {
+    if (process_record_segment_count == 0) {
+        return UINT64_MAX >> (64 - PROCESS_RECORD_ROUTE_COUNT);
+    }
+    uint8_t first = 0;
+    uint8_t last  = process_record_segment_count;
+    while (last - first > 1) {
+        uint8_t mid = first + (last - first) / 2;
+        if (process_record_segment_first[mid] <= keycode) {
+            first = mid;
+        } else {
+            last = mid;
+        }
+    }
+    return process_record_segment_routes[first];
+}
+
+/* Core keycode function, hands off handling to other functions,
+    then processes internal quantum keycodes, and then processes
+    ACTIONs.                                                      */
+bool process_record_quantum(keyrecord_t *record) {
+    uint16_t keycode = get_record_keycode(record, true);
+
+    // This is how you use actions here
+    // if (keycode == QK_LEADER) {
+    //   action_t action;
+    //   action.code = ACTION_DEFAULT_LAYER_SET(0);
+    //   process_action(record, action);
+    //   return false;
+    // }
+
+#if defined(SECURE_ENABLE)
+    if (!preprocess_secure(keycode, record)) {
+        return false;
+    }
+#endif
+
+#ifdef TAP_DANCE_ENABLE
+    if (preprocess_tap_dance(keycode, record)) {
+        // The tap dance might have updated the layer state, therefore the
+        // result of the keycode lookup might change.
+        keycode = get_record_keycode(record, true);
+    }
+#endif
+
+#ifdef RGBLIGHT_ENABLE
+    if (record->event.pressed) {
+        preprocess_rgblight();
+    }
 #endif
-            true)) {
+
+#ifdef WPM_ENABLE
+    if (record->event.pressed) {
+        update_wpm(keycode);
+    }
+#endif
+
+#if defined(KEY_LOCK_ENABLE)
+    // Must run first to be able to mask key_up events.
+    if (!process_key_lock(&keycode, record)) {
         return false;
     }
+#endif
+
+    // Only visit the routes that cover this keycode, in table order
+    uint64_t routes = process_record_routes_for(keycode);
+    while (routes != 0) {
+        const process_record_route_t *route = &process_record_routes[__builtin_ctzll(routes)];
+        routes &= routes - 1;
+        if (keycode >= route->first && keycode <= route->last && !route->handler(keycode, record)) {
+            return false;
+        }
+    }
 
     if (record->event.pressed) {
         switch (keycode) {
@@ -510,6 +621,9 @@ __attribute__((weak)) bool shutdown_kb(bool jump_to_bootloader) {
 }
 
 void suspend_power_down_quantum(void) {
+#ifdef HOST_REPORT_QUEUE_ENABLE
+    host_report_queue_flush();
+#endif
     suspend_power_down_kb();
 #ifndef NO_SUSPEND_POWER_DOWN
 // Turn off backlight
@@ -16,6 +16,14 @@ RGB_MATRIX_EFFECT(TYPING_HEATMAP)
 #        ifndef RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT
 #            define RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT 16
 #        endif
+// Squared distances below which sqrt16() would be within the spread, and give at least the area limit
+#        define HEATMAP_SPREAD_SQ ((uint32_t)(RGB_MATRIX_TYPING_HEATMAP_SPREAD + 1) * (RGB_MATRIX_TYPING_HEATMAP_SPREAD + 1))
+#        if RGB_MATRIX_TYPING_HEATMAP_SPREAD >= RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT
+#            define HEATMAP_AREA_LIMIT_SQ ((uint32_t)(RGB_MATRIX_TYPING_HEATMAP_SPREAD - RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT + 1) * (RGB_MATRIX_TYPING_HEATMAP_SPREAD - RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT + 1))
+#        else
+#            define HEATMAP_AREA_LIMIT_SQ 0
+#        endif
+
 void process_rgb_matrix_typing_heatmap(uint8_t row, uint8_t col) {
 #        ifdef RGB_MATRIX_TYPING_HEATMAP_SLIM
     // Limit effect to pressed keys
@@ -24,6 +32,7 @@ void process_rgb_matrix_typing_heatmap(uint8_t row, uint8_t col) {
     if (g_led_config.matrix_co[row][col] == NO_LED) { // skip as pressed key doesn't have an led position
         return;
     }
+    led_point_t hit = g_led_config.point[g_led_config.matrix_co[row][col]];
     for (uint8_t i_row = 0; i_row < MATRIX_ROWS; i_row++) {
         for (uint8_t i_col = 0; i_col < MATRIX_COLS; i_col++) {
             if (g_led_config.matrix_co[i_row][i_col] == NO_LED) { // skip as target key doesn't have an led position
@@ -32,16 +41,22 @@ void process_rgb_matrix_typing_heatmap(uint8_t row, uint8_t col) {
             if (i_row == row && i_col == col) {
                 g_rgb_frame_buffer[row][col] = qadd8(g_rgb_frame_buffer[row][col], RGB_MATRIX_TYPING_HEATMAP_INCREASE_STEP);
             } else {
-#            define LED_DISTANCE(led_a, led_b) sqrt16(((int16_t)(led_a.x - led_b.x) * (int16_t)(led_a.x - led_b.x)) + ((int16_t)(led_a.y - led_b.y) * (int16_t)(led_a.y - led_b.y)))
-                uint8_t distance = LED_DISTANCE(g_led_config.point[g_led_config.matrix_co[row][col]], g_led_config.point[g_led_config.matrix_co[i_row][i_col]]);
-#            undef LED_DISTANCE
-                if (distance <= RGB_MATRIX_TYPING_HEATMAP_SPREAD) {
-                    uint8_t amount = qsub8(RGB_MATRIX_TYPING_HEATMAP_SPREAD, distance);
+                led_point_t target = g_led_config.point[g_led_config.matrix_co[i_row][i_col]];
+                int16_t     dx     = target.x - hit.x;
+                int16_t     dy     = target.y - hit.y;
+                // Compare squares first, the square root is only needed where the amount falls off
+                uint16_t distance_sq = dx * dx + dy * dy;
+                if (distance_sq >= HEATMAP_SPREAD_SQ) {
+                    continue;
+                }
+                uint8_t amount = RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT;
+                if (distance_sq >= HEATMAP_AREA_LIMIT_SQ) {
+                    amount = qsub8(RGB_MATRIX_TYPING_HEATMAP_SPREAD, sqrt16(distance_sq));
                     if (amount > RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT) {
                         amount = RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT;
                     }
-                    g_rgb_frame_buffer[i_row][i_col] = qadd8(g_rgb_frame_buffer[i_row][i_col], amount);
                 }
+                g_rgb_frame_buffer[i_row][i_col] = qadd8(g_rgb_frame_buffer[i_row][i_col], amount);
             }
         }
     }
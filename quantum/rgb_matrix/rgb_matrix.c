@@ -39,6 +39,73 @@ __attribute__((weak)) RGB rgb_matrix_hsv_to_rgb(HSV hsv) {
     return hsv_to_rgb(hsv);
 }
 
+#ifdef RGB_MATRIX_GEOMETRY_CACHE
+static led_geometry_t led_geometry[RGB_MATRIX_LED_COUNT];
+#endif // RGB_MATRIX_GEOMETRY_CACHE
+
+// Distance of an LED from the center
+static inline uint8_t rgb_matrix_led_dist(uint8_t led_idx) {
+#ifdef RGB_MATRIX_GEOMETRY_CACHE
+    return led_geometry[led_idx].dist;
+#else
+    int16_t dx = g_led_config.point[led_idx].x - k_rgb_matrix_center.x;
+    int16_t dy = g_led_config.point[led_idx].y - k_rgb_matrix_center.y;
+    return sqrt16(dx * dx + dy * dy);
+#endif // RGB_MATRIX_GEOMETRY_CACHE
+}
+
+// Angle of an LED around the center
+static inline uint8_t rgb_matrix_led_angle(uint8_t led_idx) {
+#ifdef RGB_MATRIX_GEOMETRY_CACHE
+    return led_geometry[led_idx].angle;
+#else
+    int16_t dx = g_led_config.point[led_idx].x - k_rgb_matrix_center.x;
+    int16_t dy = g_led_config.point[led_idx].y - k_rgb_matrix_center.y;
+    return atan2_8(dy, dx);
+#endif // RGB_MATRIX_GEOMETRY_CACHE
+}
+
+#if defined(RGB_MATRIX_GEOMETRY_CACHE) && defined(RGB_MATRIX_KEYREACTIVE_ENABLED)
+// Distances from the LEDs of recent hits to every LED
+static uint8_t hit_dist_led[LED_HITS_TO_REMEMBER];
+static uint8_t hit_dist[LED_HITS_TO_REMEMBER][RGB_MATRIX_LED_COUNT];
+
+static const uint8_t *rgb_matrix_find_hit_dist(uint8_t hit_led, bool *used) {
+    for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; i++) {
+        if (hit_dist_led[i] == hit_led) {
+            used[i] = true;
+            return hit_dist[i];
+        }
+    }
+    return NULL;
+}
+
+// Looks up the distances for each hit from start on, computing them in place of those no longer hit
+static void rgb_matrix_hit_dist(uint8_t start, uint8_t count, const uint8_t **dist) {
+    bool used[LED_HITS_TO_REMEMBER] = {false};
+    for (uint8_t j = start; j < count; j++) {
+        dist[j] = rgb_matrix_find_hit_dist(g_last_hit_tracker.index[j], used);
+    }
+    for (uint8_t j = start; j < count; j++) {
+        if (dist[j] || (dist[j] = rgb_matrix_find_hit_dist(g_last_hit_tracker.index[j], used))) {
+            continue;
+        }
+        uint8_t slot = 0;
+        while (used[slot]) {
+            slot++;
+        }
+        used[slot]         = true;
+        hit_dist_led[slot] = g_last_hit_tracker.index[j];
+        for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+            int16_t dx        = g_led_config.point[i].x - g_last_hit_tracker.x[j];
+            int16_t dy        = g_led_config.point[i].y - g_last_hit_tracker.y[j];
+            hit_dist[slot][i] = sqrt16(dx * dx + dy * dy);
+        }
+        dist[j] = hit_dist[slot];
+    }
+}
+#endif // defined(RGB_MATRIX_GEOMETRY_CACHE) && defined(RGB_MATRIX_KEYREACTIVE_ENABLED)
+
 // Generic effect runners
 #include "rgb_matrix_runners.inc"
 
@@ -445,8 +512,23 @@ __attribute__((weak)) bool rgb_matrix_indicators_advanced_user(uint8_t led_min,
     return true;
 }
 
+void rgb_matrix_update_geometry(void) {
+#ifdef RGB_MATRIX_GEOMETRY_CACHE
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        int16_t dx            = g_led_config.point[i].x - k_rgb_matrix_center.x;
+        int16_t dy            = g_led_config.point[i].y - k_rgb_matrix_center.y;
+        led_geometry[i].dist  = sqrt16(dx * dx + dy * dy);
+        led_geometry[i].angle = atan2_8(dy, dx);
+    }
+#    ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+    memset(hit_dist_led, NO_LED, sizeof(hit_dist_led));
+#    endif // RGB_MATRIX_KEYREACTIVE_ENABLED
+#endif // RGB_MATRIX_GEOMETRY_CACHE
+}
+
 void rgb_matrix_init(void) {
     rgb_matrix_driver.init();
+    rgb_matrix_update_geometry();
 
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
     g_last_hit_tracker.count = 0;
@@ -163,6 +163,7 @@ bool rgb_matrix_indicators_advanced_kb(uint8_t led_min, uint8_t led_max);
 bool rgb_matrix_indicators_advanced_user(uint8_t led_min, uint8_t led_max);
 
 void rgb_matrix_init(void);
+void rgb_matrix_update_geometry(void);
 
 void rgb_matrix_reload_from_eeprom(void);
 
@@ -23,6 +23,12 @@
 #include "keycode.h"
 #include "action.h"
 #include "wait.h"
+#ifdef SEND_STRING_ASYNC_ENABLE
+#    include <string.h>
+#    include "deferred_exec.h"
+#    include "timer.h"
+#    include "util.h"
+#endif
 
 #if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
 #    include "audio.h"
@@ -336,3 +342,242 @@ void send_string_with_delay_P(const char *string, uint8_t interval) {
     }
 }
 #endif
+
+#ifdef SEND_STRING_ASYNC_ENABLE
+#    ifndef SEND_STRING_ASYNC_BUFFER_SIZE
+#        define SEND_STRING_ASYNC_BUFFER_SIZE 128
+#    endif
+
+/* Queued strings, each stored as its interval followed by its characters and
+ * a terminating zero. Characters are only turned into key events once they
+ * are about to be typed, so the queue costs one byte per character.         */
+static char     async_buffer[SEND_STRING_ASYNC_BUFFER_SIZE];
+static uint16_t async_buffer_read  = 0;
+static uint16_t async_buffer_count = 0;
+static bool     async_in_string    = false;
+static uint8_t  async_interval     = 0;
+
+enum { ASYNC_OP_REGISTER, ASYNC_OP_UNREGISTER, ASYNC_OP_WAIT };
+
+typedef struct {
+    uint8_t  type;
+    uint8_t  keycode;
+    uint16_t ms;
+} async_op_t;
+
+/* Key events of the character being typed, at most 16 for a dead key */
+static async_op_t async_ops[16];
+static uint8_t    async_ops_count = 0;
+static uint8_t    async_ops_next  = 0;
+
+static deferred_executor_t async_executors[1]        = {0};
+static deferred_token      async_token               = INVALID_DEFERRED_TOKEN;
+static uint32_t            async_last_execution_time = 0;
+
+static char async_peek(void) {
+    return async_buffer_count ? async_buffer[async_buffer_read] : 0;
+}
+
+static char async_pop(void) {
+    char c = async_peek();
+    if (async_buffer_count) {
+        async_buffer_read = (async_buffer_read + 1) % SEND_STRING_ASYNC_BUFFER_SIZE;
+        async_buffer_count--;
+    }
+    return c;
+}
+
+static void async_push_op(uint8_t type, uint8_t keycode, uint16_t ms) {
+    async_ops[async_ops_count++] = (async_op_t){.type = type, .keycode = keycode, .ms = ms};
+}
+
+static void async_tokenize_char(char ascii_code) {
+#    if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
+    if (ascii_code == '\a') { // BEL
+        PLAY_SONG(bell_song);
+        return;
+    }
+#    endif
+
+    uint8_t keycode    = pgm_read_byte(&ascii_to_keycode_lut[(uint8_t)ascii_code]);
+    bool    is_shifted = PGM_LOADBIT(ascii_to_shift_lut, (uint8_t)ascii_code);
+    bool    is_altgred = PGM_LOADBIT(ascii_to_altgr_lut, (uint8_t)ascii_code);
+    bool    is_dead    = PGM_LOADBIT(ascii_to_dead_lut, (uint8_t)ascii_code);
+
+    // Same sequence as send_char_with_delay()
+    if (is_shifted) {
+        async_push_op(ASYNC_OP_REGISTER, KC_LEFT_SHIFT, 0);
+        async_push_op(ASYNC_OP_WAIT, 0, async_interval);
+    }
+    if (is_altgred) {
+        async_push_op(ASYNC_OP_REGISTER, KC_RIGHT_ALT, 0);
+        async_push_op(ASYNC_OP_WAIT, 0, async_interval);
+    }
+    async_push_op(ASYNC_OP_REGISTER, keycode, 0);
+    async_push_op(ASYNC_OP_WAIT, 0, async_interval);
+    async_push_op(ASYNC_OP_UNREGISTER, keycode, 0);
+    async_push_op(ASYNC_OP_WAIT, 0, async_interval);
+    if (is_altgred) {
+        async_push_op(ASYNC_OP_UNREGISTER, KC_RIGHT_ALT, 0);
+        async_push_op(ASYNC_OP_WAIT, 0, async_interval);
+    }
+    if (is_shifted) {
+        async_push_op(ASYNC_OP_UNREGISTER, KC_LEFT_SHIFT, 0);
+        async_push_op(ASYNC_OP_WAIT, 0, async_interval);
+    }
+    if (is_dead) {
+        async_push_op(ASYNC_OP_REGISTER, KC_SPACE, 0);
+        async_push_op(ASYNC_OP_WAIT, 0, TAP_CODE_DELAY);
+        async_push_op(ASYNC_OP_UNREGISTER, KC_SPACE, 0);
+        async_push_op(ASYNC_OP_WAIT, 0, async_interval);
+    }
+}
+
+/* Turns the next character or SS_* code of the queue into key events */
+static bool async_tokenize(void) {
+    async_ops_count = async_ops_next = 0;
+
+    while (!async_ops_count) {
+        if (!async_buffer_count) {
+            return false;
+        }
+        if (!async_in_string) {
+            async_interval  = async_pop();
+            async_in_string = true;
+            continue;
+        }
+
+        char ascii_code = async_pop();
+        if (!ascii_code) {
+            async_in_string = false;
+        } else if (ascii_code == SS_QMK_PREFIX) {
+            // A truncated code leaves the terminator in place for the next round
+            char    code    = async_peek() ? async_pop() : 0;
+            uint8_t keycode = (code == SS_TAP_CODE || code == SS_DOWN_CODE || code == SS_UP_CODE) && async_peek() ? async_pop() : 0;
+
+            if (code == SS_TAP_CODE && keycode) {
+                async_push_op(ASYNC_OP_REGISTER, keycode, 0);
+                async_push_op(ASYNC_OP_WAIT, 0, keycode == KC_CAPS_LOCK ? TAP_HOLD_CAPS_DELAY : TAP_CODE_DELAY);
+                async_push_op(ASYNC_OP_UNREGISTER, keycode, 0);
+            } else if (code == SS_DOWN_CODE && keycode) {
+                async_push_op(ASYNC_OP_REGISTER, keycode, 0);
+            } else if (code == SS_UP_CODE && keycode) {
+                async_push_op(ASYNC_OP_UNREGISTER, keycode, 0);
+            } else if (code == SS_DELAY_CODE) {
+                uint32_t ms = 0;
+                while (isdigit(async_peek())) {
+                    ms = ms * 10 + (async_pop() - '0');
+                }
+                // Skip the delimiter
+                if (async_peek()) {
+                    async_pop();
+                }
+                async_push_op(ASYNC_OP_WAIT, 0, ms > UINT16_MAX ? UINT16_MAX : ms);
+            }
+            if (async_ops_count) {
+                async_push_op(ASYNC_OP_WAIT, 0, async_interval);
+            }
+        } else {
+            async_tokenize_char(ascii_code);
+        }
+    }
+
+    return true;
+}
+
+/* Types out one character or SS_* code per call, and waits where the blocking
+ * send_string() would have called wait_ms().                                 */
+static uint32_t async_callback(uint32_t trigger_time, void *cb_arg) {
+    if (async_ops_next == async_ops_count && !async_tokenize()) {
+        async_token = INVALID_DEFERRED_TOKEN;
+        return 0;
+    }
+
+    while (async_ops_next < async_ops_count) {
+        const async_op_t *op = &async_ops[async_ops_next++];
+        switch (op->type) {
+            case ASYNC_OP_REGISTER:
+                register_code(op->keycode);
+                break;
+            case ASYNC_OP_UNREGISTER:
+                unregister_code(op->keycode);
+                break;
+            case ASYNC_OP_WAIT:
+                if (op->ms) {
+                    return op->ms;
+                }
+                break;
+        }
+    }
+
+    // Let the main loop run before the next character
+    return 1;
+}
+
+static bool async_enqueue(const char *string, uint8_t interval, bool progmem) {
+    uint16_t length = progmem ? strlen_P(string) : strlen(string);
+    if ((uint32_t)length + 2 > SEND_STRING_ASYNC_BUFFER_SIZE - async_buffer_count) {
+        return false;
+    }
+
+    if (async_token == INVALID_DEFERRED_TOKEN) {
+        async_token = defer_exec_advanced(async_executors, ARRAY_SIZE(async_executors), 1, async_callback, NULL);
+        if (async_token == INVALID_DEFERRED_TOKEN) {
+            return false;
+        }
+        // Nothing ran while idle, restart the once per millisecond throttle from now
+        async_last_execution_time = timer_read32();
+    }
+
+    uint16_t write = (async_buffer_read + async_buffer_count) % SEND_STRING_ASYNC_BUFFER_SIZE;
+    async_buffer[write] = interval;
+    for (uint16_t i = 0; i <= length; i++) {
+        write               = (write + 1) % SEND_STRING_ASYNC_BUFFER_SIZE;
+        async_buffer[write] = progmem ? pgm_read_byte(&string[i]) : string[i];
+    }
+    async_buffer_count += length + 2;
+    return true;
+}
+
+bool send_string_async(const char *string) {
+    return send_string_async_with_delay(string, TAP_CODE_DELAY);
+}
+
+bool send_string_async_with_delay(const char *string, uint8_t interval) {
+    return async_enqueue(string, interval, false);
+}
+
+#    if defined(__AVR__)
+bool send_string_async_with_delay_P(const char *string, uint8_t interval) {
+    return async_enqueue(string, interval, true);
+}
+#    endif
+
+void send_string_async_cancel(void) {
+    // Release what the current character still holds down
+    while (async_ops_next < async_ops_count) {
+        const async_op_t *op = &async_ops[async_ops_next++];
+        if (op->type == ASYNC_OP_UNREGISTER) {
+            unregister_code(op->keycode);
+        }
+    }
+    async_ops_count = async_ops_next = 0;
+    async_buffer_count               = 0;
+    async_in_string                  = false;
+
+    cancel_deferred_exec_advanced(async_executors, ARRAY_SIZE(async_executors), async_token);
+    async_token = INVALID_DEFERRED_TOKEN;
+}
+
+bool send_string_async_is_busy(void) {
+    return async_token != INVALID_DEFERRED_TOKEN;
+}
+
+uint32_t send_string_async_time_until_next(void) {
+    return deferred_exec_advanced_time_until_next(async_executors, ARRAY_SIZE(async_executors));
+}
+
+void send_string_async_task(void) {
+    deferred_exec_advanced_task(async_executors, ARRAY_SIZE(async_executors), &async_last_execution_time);
+}
+#endif
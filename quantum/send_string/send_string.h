@@ -23,6 +23,7 @@
  * \{
  */
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include "progmem.h"
@@ -161,4 +162,64 @@ void send_string_with_delay_P(const char *string, uint8_t interval);
  */
 #define SEND_STRING_DELAY(string, interval) send_string_with_delay_P(PSTR(string), interval)
 
+#if defined(SEND_STRING_ASYNC_ENABLE) || defined(__DOXYGEN__)
+/**
+ * \brief Queue a string of ASCII characters to be typed out in the background.
+ *
+ * The string is copied, so it may be a temporary. It is typed out from the main loop, one character per millisecond
+ * or per `interval` if that is longer, while keys keep being scanned and processed. Queued strings are typed out in
+ * the order they were queued.
+ *
+ * \param string The string to type out.
+ * \param interval The amount of time, in milliseconds, to wait before typing the next character.
+ * \return false if the queue does not have room for the whole string, in which case nothing was queued.
+ */
+bool send_string_async_with_delay(const char *string, uint8_t interval);
+
+/**
+ * \brief Queue a string of ASCII characters to be typed out in the background.
+ *
+ * This function simply calls `send_string_async_with_delay(string, TAP_CODE_DELAY)`.
+ */
+bool send_string_async(const char *string);
+
+/**
+ * \brief Stop typing out queued strings and drop them.
+ *
+ * Keys held down by the character being typed are released. Keys held down with `SS_DOWN()` stay down.
+ */
+void send_string_async_cancel(void);
+
+/**
+ * \brief Whether queued strings are still being typed out.
+ */
+bool send_string_async_is_busy(void);
+
+/**
+ * \brief The number of milliseconds until the next queued key event is due, or UINT32_MAX if nothing is queued.
+ */
+uint32_t send_string_async_time_until_next(void);
+
+/**
+ * \brief Types out the queued strings. Called from keyboard_task().
+ */
+void send_string_async_task(void);
+
+#    if defined(__AVR__) || defined(__DOXYGEN__)
+/**
+ * \brief Queue a PROGMEM string of ASCII characters to be typed out in the background.
+ *
+ * On ARM devices, this function is simply an alias for send_string_async_with_delay(string, interval).
+ */
+bool send_string_async_with_delay_P(const char *string, uint8_t interval);
+#    else
+#        define send_string_async_with_delay_P(string, interval) send_string_async_with_delay(string, interval)
+#    endif
+
+/**
+ * \brief Shortcut macro for send_string_async_with_delay_P(PSTR(string), 0).
+ */
+#    define SEND_STRING_ASYNC(string) send_string_async_with_delay_P(PSTR(string), 0)
+#endif
+
 /** \} */
@@ -0,0 +1,56 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "debug.h"
+
+/* Fixed-size arrays kept sorted by keycode, used by combos, key overrides and
+ * leader sequences to look up the few entries a key can match. Entries that
+ * compare equal keep the order they were inserted in. */
+
+typedef enum {
+    SORTED_INDEX_INVALID,  // not built yet, lookups scan all entries
+    SORTED_INDEX_VALID,    // lookups go through the index
+    SORTED_INDEX_OVERFLOW, // too many entries, lookups scan all of them
+} sorted_index_state_t;
+
+/* Returns <0, 0 or >0 when `a` sorts before, with or after `b` */
+typedef int (*sorted_index_compare_t)(const void *a, const void *b);
+
+/**
+ * @brief Inserts `entry` into the `*size` sorted entries at `base`, after the
+ * entries it compares equal to. There must be room for one more entry.
+ */
+static inline void sorted_index_insert(void *base, uint16_t *size, size_t entry_size, const void *entry, sorted_index_compare_t compare) {
+    uint8_t *entries = base;
+    uint16_t pos     = *size;
+    while (pos > 0 && compare(entries + (pos - 1) * entry_size, entry) > 0) {
+        --pos;
+    }
+    memmove(entries + (pos + 1) * entry_size, entries + pos * entry_size, (*size - pos) * entry_size);
+    memcpy(entries + pos * entry_size, entry, entry_size);
+    ++*size;
+}
+
+/**
+ * @brief Returns the position of the first entry in `[first, last)` that
+ * `compare_key(entry, key)` does not place before `key`, or `last` if none.
+ */
+static inline uint16_t sorted_index_lower_bound(const void *base, uint16_t first, uint16_t last, size_t entry_size, const void *key, sorted_index_compare_t compare_key) {
+    const uint8_t *entries = base;
+    while (first < last) {
+        uint16_t mid = first + (last - first) / 2;
+        if (compare_key(entries + mid * entry_size, key) < 0) {
+            first = mid + 1;
+        } else {
+            last = mid;
+        }
+    }
+    return first;
+}
+
+#define sorted_index_print_overflow(feature, count, entries, size_define) dprintf(feature ": %u " entries " do not fit in " #size_define ", scanning all of them\n", (unsigned)(count))
@@ -0,0 +1,404 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "task_profiler.h"
+#include "timer.h"
+#include "debug.h"
+#include "print.h"
+#include "util.h"
+
+#ifdef RAW_ENABLE
+#    include "raw_hid.h"
+#endif
+
+#if defined(PROTOCOL_CHIBIOS)
+#    include <ch.h>
+#    include "chibios_config.h"
+#    define TASK_PROFILER_TICKS_PER_US (REALTIME_COUNTER_CLOCK / 1000000)
+#elif defined(__AVR__)
+#    include <util/atomic.h>
+#    include "timer_avr.h"
+#    define TASK_PROFILER_TICKS_PER_US 1
+// Set by timer 0 reaching TIMER_RAW_TOP, cleared once its interrupt has counted the millisecond
+#    if defined(__AVR_ATmega32A__)
+#        define TASK_PROFILER_TIMER_WRAPPED() (TIFR & _BV(OCF0))
+#    elif defined(__AVR_ATtiny85__)
+#        define TASK_PROFILER_TIMER_WRAPPED() (TIFR & _BV(OCF0A))
+#    else
+#        define TASK_PROFILER_TIMER_WRAPPED() (TIFR0 & _BV(OCF0A))
+#    endif
+#else
+// Test platform: the fake clock only counts milliseconds
+#    define TASK_PROFILER_TICKS_PER_US 1
+#endif
+
+#if TASK_PROFILER_TICKS_PER_US < 1
+#    error Profiling clock is slower than 1MHz
+#endif
+
+static const char *const task_names[TASK_PROFILER_TASK_COUNT] = {
+    [TASK_PROFILER_KEYBOARD]      = "keyboard",
+    [TASK_PROFILER_QUANTUM]       = "quantum",
+    [TASK_PROFILER_PROTOCOL_PRE]  = "protocol_pre",
+    [TASK_PROFILER_PROTOCOL_POST] = "protocol_post",
+    [TASK_PROFILER_MATRIX]        = "matrix",
+#ifdef KEY_EVENT_QUEUE_ENABLE
+    [TASK_PROFILER_KEY_EVENT_QUEUE] = "key_event_queue",
+#endif
+#ifdef HOST_REPORT_QUEUE_ENABLE
+    [TASK_PROFILER_HOST_REPORT_QUEUE] = "host_report_queue",
+#endif
+#ifdef RAW_ENABLE
+    [TASK_PROFILER_RAW_HID] = "raw_hid",
+#endif
+#ifdef CONSOLE_ENABLE
+    [TASK_PROFILER_CONSOLE] = "console",
+#endif
+#ifdef QUANTUM_PAINTER_ENABLE
+    [TASK_PROFILER_QUANTUM_PAINTER] = "quantum_painter",
+#endif
+#ifdef DEFERRED_EXEC_ENABLE
+    [TASK_PROFILER_DEFERRED_EXEC] = "deferred_exec",
+#endif
+    [TASK_PROFILER_HOUSEKEEPING] = "housekeeping",
+#if defined(AUDIO_ENABLE) && !defined(NO_MUSIC_MODE)
+    [TASK_PROFILER_MUSIC] = "music",
+#endif
+#ifdef KEY_OVERRIDE_ENABLE
+    [TASK_PROFILER_KEY_OVERRIDE] = "key_override",
+#endif
+#ifdef SEQUENCER_ENABLE
+    [TASK_PROFILER_SEQUENCER] = "sequencer",
+#endif
+#ifdef TAP_DANCE_ENABLE
+    [TASK_PROFILER_TAP_DANCE] = "tap_dance",
+#endif
+#ifdef COMBO_ENABLE
+    [TASK_PROFILER_COMBO] = "combo",
+#endif
+#ifdef LEADER_ENABLE
+    [TASK_PROFILER_LEADER] = "leader",
+#endif
+#if defined(STENO_ENABLE) && defined(STENO_OUTPUT_QUEUE)
+    [TASK_PROFILER_STENO] = "steno",
+#endif
+#ifdef WPM_ENABLE
+    [TASK_PROFILER_WPM] = "wpm",
+#endif
+#ifdef DIP_SWITCH_ENABLE
+    [TASK_PROFILER_DIP_SWITCH] = "dip_switch",
+#endif
+#ifdef AUTO_SHIFT_ENABLE
+    [TASK_PROFILER_AUTO_SHIFT] = "auto_shift",
+#endif
+#ifdef CAPS_WORD_ENABLE
+    [TASK_PROFILER_CAPS_WORD] = "caps_word",
+#endif
+#ifdef SECURE_ENABLE
+    [TASK_PROFILER_SECURE] = "secure",
+#endif
+#if defined(SPLIT_WATCHDOG_ENABLE)
+    [TASK_PROFILER_SPLIT_WATCHDOG] = "split_watchdog",
+#endif
+#ifdef RGBLIGHT_ENABLE
+    [TASK_PROFILER_RGBLIGHT] = "rgblight",
+#endif
+#ifdef LED_MATRIX_ENABLE
+    [TASK_PROFILER_LED_MATRIX] = "led_matrix",
+#endif
+#ifdef RGB_MATRIX_ENABLE
+    [TASK_PROFILER_RGB_MATRIX] = "rgb_matrix",
+#endif
+#if defined(BACKLIGHT_ENABLE) && (defined(BACKLIGHT_PIN) || defined(BACKLIGHT_PINS))
+    [TASK_PROFILER_BACKLIGHT] = "backlight",
+#endif
+#ifdef ENCODER_ENABLE
+    [TASK_PROFILER_ENCODER] = "encoder",
+#endif
+#ifdef POINTING_DEVICE_ENABLE
+    [TASK_PROFILER_POINTING_DEVICE] = "pointing_device",
+#endif
+#ifdef OLED_ENABLE
+    [TASK_PROFILER_OLED] = "oled",
+#endif
+#ifdef ST7565_ENABLE
+    [TASK_PROFILER_ST7565] = "st7565",
+#endif
+#ifdef MOUSEKEY_ENABLE
+    [TASK_PROFILER_MOUSEKEY] = "mousekey",
+#endif
+#ifdef PS2_MOUSE_ENABLE
+    [TASK_PROFILER_PS2_MOUSE] = "ps2_mouse",
+#endif
+#ifdef MIDI_ENABLE
+    [TASK_PROFILER_MIDI] = "midi",
+#endif
+#ifdef JOYSTICK_ENABLE
+    [TASK_PROFILER_JOYSTICK] = "joystick",
+#endif
+#ifdef BLUETOOTH_ENABLE
+    [TASK_PROFILER_BLUETOOTH] = "bluetooth",
+#endif
+#ifdef HAPTIC_ENABLE
+    [TASK_PROFILER_HAPTIC] = "haptic",
+#endif
+    [TASK_PROFILER_LED] = "led",
+#ifdef OS_DETECTION_ENABLE
+    [TASK_PROFILER_OS_DETECTION] = "os_detection",
+#endif
+#if defined(DYNAMIC_KEYMAP_ENABLE) && defined(DYNAMIC_KEYMAP_RAM_SHADOW)
+    [TASK_PROFILER_DYNAMIC_KEYMAP] = "dynamic_keymap",
+#endif
+#ifdef SEND_STRING_ASYNC_ENABLE
+    [TASK_PROFILER_SEND_STRING_ASYNC] = "send_string_async",
+#endif
+};
+
+static task_profiler_stats_t task_stats[TASK_PROFILER_TASK_COUNT];
+static task_profiler_task_t  worst_task = TASK_PROFILER_TASK_COUNT;
+static uint32_t              worst_us;
+static uint32_t              worst_time;
+
+uint32_t task_profiler_timestamp(void) {
+#if defined(PROTOCOL_CHIBIOS)
+    return chSysGetRealtimeCounterX();
+#elif defined(__AVR__)
+    // Milliseconds from the timer interrupt plus the sub-millisecond progress of timer 0
+    uint32_t ms;
+    uint8_t  raw;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        ms  = timer_count;
+        raw = TIMER_RAW;
+        // Timer 0 wrapped while interrupts were off, so timer_count is one millisecond behind
+        if (TASK_PROFILER_TIMER_WRAPPED()) {
+            ms++;
+            raw = TIMER_RAW;
+        }
+    }
+    return ms * 1000 + (uint32_t)raw * 1000 / (TIMER_RAW_TOP + 1);
+#else
+    return timer_read32() * 1000;
+#endif
+}
+
+static uint8_t histogram_bucket(uint32_t duration_us) {
+    uint8_t bucket = 0;
+    while (duration_us && bucket < TASK_PROFILER_HISTOGRAM_BUCKETS - 1) {
+        duration_us >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+void task_profiler_record(task_profiler_task_t task, uint32_t start) {
+    uint32_t               elapsed     = task_profiler_timestamp() - start;
+    task_profiler_stats_t *stats       = &task_stats[task];
+
+    // A clock that stepped backwards must not show up as a huge duration
+    if ((int32_t)elapsed < 0) {
+        elapsed = 0;
+    }
+    uint32_t duration_us = elapsed / TASK_PROFILER_TICKS_PER_US;
+
+    // Halve everything rather than overflow, which keeps the average and the distribution
+    if (stats->total_us > UINT32_MAX - duration_us || stats->count == UINT32_MAX) {
+        stats->total_us /= 2;
+        stats->count /= 2;
+    }
+    if (stats->count == 0 || duration_us < stats->min_us) {
+        stats->min_us = duration_us;
+    }
+    if (duration_us > stats->max_us) {
+        stats->max_us = duration_us;
+    }
+    stats->total_us += duration_us;
+    stats->count++;
+
+    uint8_t bucket = histogram_bucket(duration_us);
+    if (stats->histogram[bucket] == UINT16_MAX) {
+        for (uint8_t i = 0; i < TASK_PROFILER_HISTOGRAM_BUCKETS; i++) {
+            stats->histogram[i] /= 2;
+        }
+    }
+    stats->histogram[bucket]++;
+
+    if (task >= TASK_PROFILER_FIRST_LEAF && (worst_task == TASK_PROFILER_TASK_COUNT || duration_us > worst_us)) {
+        worst_task = task;
+        worst_us   = duration_us;
+        worst_time = timer_read32();
+    }
+}
+
+void task_profiler_reset(void) {
+    memset(task_stats, 0, sizeof(task_stats));
+    worst_task = TASK_PROFILER_TASK_COUNT;
+    worst_us   = 0;
+    worst_time = 0;
+}
+
+const task_profiler_stats_t *task_profiler_get_stats(task_profiler_task_t task) {
+    if (task >= TASK_PROFILER_TASK_COUNT) {
+        return NULL;
+    }
+    return &task_stats[task];
+}
+
+const char *task_profiler_get_name(task_profiler_task_t task) {
+    if (task >= TASK_PROFILER_TASK_COUNT) {
+        return "";
+    }
+    return task_names[task];
+}
+
+uint32_t task_profiler_get_avg(task_profiler_task_t task) {
+    const task_profiler_stats_t *stats = task_profiler_get_stats(task);
+    if (!stats || !stats->count) {
+        return 0;
+    }
+    return stats->total_us / stats->count;
+}
+
+uint32_t task_profiler_get_p99(task_profiler_task_t task) {
+    const task_profiler_stats_t *stats = task_profiler_get_stats(task);
+    if (!stats) {
+        return 0;
+    }
+
+    uint32_t samples = 0;
+    for (uint8_t i = 0; i < TASK_PROFILER_HISTOGRAM_BUCKETS; i++) {
+        samples += stats->histogram[i];
+    }
+    if (!samples) {
+        return 0;
+    }
+
+    // Smallest bucket that covers at least 99% of the samples
+    uint32_t target = samples - samples / 100;
+    uint32_t seen   = 0;
+    // The last bucket is open ended, so only the maximum bounds it
+    for (uint8_t i = 0; i < TASK_PROFILER_HISTOGRAM_BUCKETS - 1; i++) {
+        seen += stats->histogram[i];
+        if (seen >= target) {
+            uint32_t upper = (i == 0) ? 0 : ((uint32_t)1 << i) - 1;
+            return MIN(upper, stats->max_us);
+        }
+    }
+    return stats->max_us;
+}
+
+task_profiler_task_t task_profiler_get_worst(uint32_t *duration_us, uint32_t *when) {
+    if (duration_us) {
+        *duration_us = worst_us;
+    }
+    if (when) {
+        *when = worst_time;
+    }
+    return worst_task;
+}
+
+void task_profiler_print(void) {
+    uprintf("%-16s %10s %8s %8s %8s %8s\n", "task", "count", "min", "avg", "p99", "max");
+    for (task_profiler_task_t task = 0; task < TASK_PROFILER_TASK_COUNT; task++) {
+        const task_profiler_stats_t *stats = &task_stats[task];
+        if (!stats->count) {
+            continue;
+        }
+        uprintf("%-16s %10lu %8lu %8lu %8lu %8lu\n", task_names[task], stats->count, stats->min_us, task_profiler_get_avg(task), task_profiler_get_p99(task), stats->max_us);
+    }
+    if (worst_task != TASK_PROFILER_TASK_COUNT) {
+        uprintf("worst: %s took %luus at %lums\n", task_names[worst_task], worst_us, worst_time);
+    }
+}
+
+static void write_u32(uint8_t *data, uint32_t value) {
+    data[0] = (value >> 24) & 0xFF;
+    data[1] = (value >> 16) & 0xFF;
+    data[2] = (value >> 8) & 0xFF;
+    data[3] = value & 0xFF;
+}
+
+void task_profiler_raw_hid_query(uint8_t *data, uint8_t length) {
+    // data = [ command_id, sub_command_id, task, reply... ]
+    uint8_t             *sub_command_id = &(data[1]);
+    task_profiler_task_t task           = (task_profiler_task_t)data[2];
+    uint8_t             *reply          = &(data[3]);
+    uint8_t              reply_length   = length - 3;
+
+    switch (*sub_command_id) {
+        case id_task_profiler_get_task_count: {
+            data[2] = TASK_PROFILER_TASK_COUNT;
+            break;
+        }
+        case id_task_profiler_get_task_name: {
+            // NUL terminated, truncated to fit
+            strncpy((char *)reply, task_profiler_get_name(task), reply_length - 1);
+            reply[reply_length - 1] = 0;
+            break;
+        }
+        case id_task_profiler_get_stats: {
+            // reply = [ count, min, avg, p99, max ], big endian
+            const task_profiler_stats_t *stats = task_profiler_get_stats(task);
+            if (!stats || reply_length < 20) {
+                *sub_command_id = id_task_profiler_unhandled;
+                break;
+            }
+            write_u32(&reply[0], stats->count);
+            write_u32(&reply[4], stats->min_us);
+            write_u32(&reply[8], task_profiler_get_avg(task));
+            write_u32(&reply[12], task_profiler_get_p99(task));
+            write_u32(&reply[16], stats->max_us);
+            break;
+        }
+        case id_task_profiler_get_histogram: {
+            // reply = [ buckets... ], big endian 16 bit counts, as many as fit
+            const task_profiler_stats_t *stats = task_profiler_get_stats(task);
+            if (!stats) {
+                *sub_command_id = id_task_profiler_unhandled;
+                break;
+            }
+            for (uint8_t i = 0; i < TASK_PROFILER_HISTOGRAM_BUCKETS && (i * 2 + 1) < reply_length; i++) {
+                reply[i * 2]     = stats->histogram[i] >> 8;
+                reply[i * 2 + 1] = stats->histogram[i] & 0xFF;
+            }
+            break;
+        }
+        case id_task_profiler_get_worst: {
+            // task = worst task, reply = [ duration, time ], big endian
+            uint32_t duration_us, when;
+            data[2] = task_profiler_get_worst(&duration_us, &when);
+            write_u32(&reply[0], duration_us);
+            write_u32(&reply[4], when);
+            break;
+        }
+        case id_task_profiler_reset: {
+            task_profiler_reset();
+            break;
+        }
+        default: {
+            *sub_command_id = id_task_profiler_unhandled;
+            break;
+        }
+    }
+}
+
+bool task_profiler_raw_hid_receive(uint8_t *data, uint8_t length) {
+    if (data[0] != TASK_PROFILER_RAW_HID_COMMAND) {
+        return false;
+    }
+    task_profiler_raw_hid_query(data, length);
+#ifdef RAW_ENABLE
+    raw_hid_send(data, length);
+#endif
+    return true;
+}
+
+void task_profiler_task(void) {
+#if TASK_PROFILER_PRINT_INTERVAL > 0
+    static uint32_t last_print = 0;
+    if (debug_enable && timer_elapsed32(last_print) >= TASK_PROFILER_PRINT_INTERVAL) {
+        last_print = timer_read32();
+        task_profiler_print();
+    }
+#endif
+}
@@ -0,0 +1,270 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+    Accounts for the time spent in each task of the main loop.
+
+    Every task called from the main loop, keyboard_task() and quantum_task() is
+    wrapped with TASK_PROFILE(), which measures it with the finest clock the
+    platform has and folds the result into per-task statistics: call count,
+    min/avg/max, a log2 histogram and a p99 estimate derived from it. The single
+    slowest call of any task is remembered as the worst offender.
+
+    The statistics can be printed over console, queried over raw HID, or read
+    directly with task_profiler_get_stats().
+*/
+
+#ifndef TASK_PROFILER_HISTOGRAM_BUCKETS
+#    define TASK_PROFILER_HISTOGRAM_BUCKETS 16
+#endif
+
+#ifndef TASK_PROFILER_PRINT_INTERVAL
+#    define TASK_PROFILER_PRINT_INTERVAL 5000
+#endif
+
+#ifndef TASK_PROFILER_RAW_HID_COMMAND
+#    define TASK_PROFILER_RAW_HID_COMMAND 0xF0
+#endif
+
+/**
+ * @brief The profiled tasks. Tasks before TASK_PROFILER_FIRST_LEAF contain other
+ * profiled tasks and are never reported as the worst offender.
+ */
+typedef enum task_profiler_task_t {
+    TASK_PROFILER_KEYBOARD,
+    TASK_PROFILER_QUANTUM,
+    TASK_PROFILER_FIRST_LEAF,
+    TASK_PROFILER_PROTOCOL_PRE = TASK_PROFILER_FIRST_LEAF,
+    TASK_PROFILER_PROTOCOL_POST,
+    TASK_PROFILER_MATRIX,
+#ifdef KEY_EVENT_QUEUE_ENABLE
+    TASK_PROFILER_KEY_EVENT_QUEUE,
+#endif
+#ifdef HOST_REPORT_QUEUE_ENABLE
+    TASK_PROFILER_HOST_REPORT_QUEUE,
+#endif
+#ifdef RAW_ENABLE
+    TASK_PROFILER_RAW_HID,
+#endif
+#ifdef CONSOLE_ENABLE
+    TASK_PROFILER_CONSOLE,
+#endif
+#ifdef QUANTUM_PAINTER_ENABLE
+    TASK_PROFILER_QUANTUM_PAINTER,
+#endif
+#ifdef DEFERRED_EXEC_ENABLE
+    TASK_PROFILER_DEFERRED_EXEC,
+#endif
+    TASK_PROFILER_HOUSEKEEPING,
+#if defined(AUDIO_ENABLE) && !defined(NO_MUSIC_MODE)
+    TASK_PROFILER_MUSIC,
+#endif
+#ifdef KEY_OVERRIDE_ENABLE
+    TASK_PROFILER_KEY_OVERRIDE,
+#endif
+#ifdef SEQUENCER_ENABLE
+    TASK_PROFILER_SEQUENCER,
+#endif
+#ifdef TAP_DANCE_ENABLE
+    TASK_PROFILER_TAP_DANCE,
+#endif
+#ifdef COMBO_ENABLE
+    TASK_PROFILER_COMBO,
+#endif
+#ifdef LEADER_ENABLE
+    TASK_PROFILER_LEADER,
+#endif
+#if defined(STENO_ENABLE) && defined(STENO_OUTPUT_QUEUE)
+    TASK_PROFILER_STENO,
+#endif
+#ifdef WPM_ENABLE
+    TASK_PROFILER_WPM,
+#endif
+#ifdef DIP_SWITCH_ENABLE
+    TASK_PROFILER_DIP_SWITCH,
+#endif
+#ifdef AUTO_SHIFT_ENABLE
+    TASK_PROFILER_AUTO_SHIFT,
+#endif
+#ifdef CAPS_WORD_ENABLE
+    TASK_PROFILER_CAPS_WORD,
+#endif
+#ifdef SECURE_ENABLE
+    TASK_PROFILER_SECURE,
+#endif
+#if defined(SPLIT_WATCHDOG_ENABLE)
+    TASK_PROFILER_SPLIT_WATCHDOG,
+#endif
+#ifdef RGBLIGHT_ENABLE
+    TASK_PROFILER_RGBLIGHT,
+#endif
+#ifdef LED_MATRIX_ENABLE
+    TASK_PROFILER_LED_MATRIX,
+#endif
+#ifdef RGB_MATRIX_ENABLE
+    TASK_PROFILER_RGB_MATRIX,
+#endif
+#if defined(BACKLIGHT_ENABLE) && (defined(BACKLIGHT_PIN) || defined(BACKLIGHT_PINS))
+    TASK_PROFILER_BACKLIGHT,
+#endif
+#ifdef ENCODER_ENABLE
+    TASK_PROFILER_ENCODER,
+#endif
+#ifdef POINTING_DEVICE_ENABLE
+    TASK_PROFILER_POINTING_DEVICE,
+#endif
+#ifdef OLED_ENABLE
+    TASK_PROFILER_OLED,
+#endif
+#ifdef ST7565_ENABLE
+    TASK_PROFILER_ST7565,
+#endif
+#ifdef MOUSEKEY_ENABLE
+    TASK_PROFILER_MOUSEKEY,
+#endif
+#ifdef PS2_MOUSE_ENABLE
+    TASK_PROFILER_PS2_MOUSE,
+#endif
+#ifdef MIDI_ENABLE
+    TASK_PROFILER_MIDI,
+#endif
+#ifdef JOYSTICK_ENABLE
+    TASK_PROFILER_JOYSTICK,
+#endif
+#ifdef BLUETOOTH_ENABLE
+    TASK_PROFILER_BLUETOOTH,
+#endif
+#ifdef HAPTIC_ENABLE
+    TASK_PROFILER_HAPTIC,
+#endif
+    TASK_PROFILER_LED,
+#ifdef OS_DETECTION_ENABLE
+    TASK_PROFILER_OS_DETECTION,
+#endif
+#if defined(DYNAMIC_KEYMAP_ENABLE) && defined(DYNAMIC_KEYMAP_RAM_SHADOW)
+    TASK_PROFILER_DYNAMIC_KEYMAP,
+#endif
+#ifdef SEND_STRING_ASYNC_ENABLE
+    TASK_PROFILER_SEND_STRING_ASYNC,
+#endif
+    TASK_PROFILER_TASK_COUNT,
+} task_profiler_task_t;
+
+/**
+ * @brief Accumulated timings of one task, all durations in microseconds.
+ */
+typedef struct task_profiler_stats_t {
+    uint32_t count;
+    uint32_t total_us;
+    uint32_t min_us;
+    uint32_t max_us;
+    // bucket 0 counts calls under 1us, bucket n calls of [2^(n-1), 2^n) us, the last bucket is open ended
+    uint16_t histogram[TASK_PROFILER_HISTOGRAM_BUCKETS];
+} task_profiler_stats_t;
+
+/**
+ * @brief Raw HID sub-commands, sent as [TASK_PROFILER_RAW_HID_COMMAND, sub-command, task, ...].
+ */
+enum task_profiler_raw_hid_id {
+    id_task_profiler_get_task_count = 0x01,
+    id_task_profiler_get_task_name  = 0x02,
+    id_task_profiler_get_stats      = 0x03,
+    id_task_profiler_get_histogram  = 0x04,
+    id_task_profiler_get_worst      = 0x05,
+    id_task_profiler_reset          = 0x06,
+    id_task_profiler_unhandled      = 0xFF,
+};
+
+#ifdef TASK_PROFILER_ENABLE
+
+/**
+ * @brief Runs the given statement(s), accounting the time taken to `task`.
+ */
+#    define TASK_PROFILE(task, ...)                                   \
+        do {                                                          \
+            uint32_t task_profiler_start = task_profiler_timestamp(); \
+            __VA_ARGS__;                                              \
+            task_profiler_record((task), task_profiler_start);        \
+        } while (0)
+
+/**
+ * @brief Reads the profiling clock, in platform specific ticks.
+ */
+uint32_t task_profiler_timestamp(void);
+
+/**
+ * @brief Accounts the time elapsed since `start` to `task`.
+ */
+void task_profiler_record(task_profiler_task_t task, uint32_t start);
+
+/**
+ * @brief Clears all statistics and the worst offender.
+ */
+void task_profiler_reset(void);
+
+/**
+ * @brief Returns the statistics of `task`, or NULL if it is out of range.
+ */
+const task_profiler_stats_t *task_profiler_get_stats(task_profiler_task_t task);
+
+/**
+ * @brief Returns the human readable name of `task`.
+ */
+const char *task_profiler_get_name(task_profiler_task_t task);
+
+/**
+ * @brief Returns the average duration of `task` in microseconds.
+ */
+uint32_t task_profiler_get_avg(task_profiler_task_t task);
+
+/**
+ * @brief Estimates the 99th percentile duration of `task` in microseconds from its histogram.
+ *
+ * The result is the upper bound of the bucket the percentile falls into, capped at the maximum.
+ */
+uint32_t task_profiler_get_p99(task_profiler_task_t task);
+
+/**
+ * @brief Returns the task with the single slowest call since the last reset, or
+ * TASK_PROFILER_TASK_COUNT if nothing has been recorded yet.
+ *
+ * @param duration_us[out] optional, the duration of that call
+ * @param when[out] optional, timer_read32() at the time of that call
+ */
+task_profiler_task_t task_profiler_get_worst(uint32_t *duration_us, uint32_t *when);
+
+/**
+ * @brief Prints all statistics over console.
+ */
+void task_profiler_print(void);
+
+/**
+ * @brief Answers a profiler query in place, `data` is [command, sub-command, task, ...].
+ */
+void task_profiler_raw_hid_query(uint8_t *data, uint8_t length);
+
+/**
+ * @brief Handles a raw HID packet addressed to the profiler and sends the reply.
+ *
+ * @return true if the packet was a profiler query
+ */
+bool task_profiler_raw_hid_receive(uint8_t *data, uint8_t length);
+
+/**
+ * @brief Periodically prints the statistics while debug is enabled. Called from keyboard_task().
+ */
+void task_profiler_task(void);
+
+#else
+
+#    define TASK_PROFILE(task, ...) \
+        do {                        \
+            __VA_ARGS__;            \
+        } while (0)
+
+#endif
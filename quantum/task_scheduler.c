@@ -0,0 +1,177 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <stddef.h>
+#include "task_scheduler.h"
+#include "timer.h"
+#include "debug.h"
+
+typedef struct task_scheduler_task_t {
+    task_scheduler_callback_t callback;
+    const char *              name;
+    uint32_t                  due_time;
+    uint16_t                  period;
+    uint16_t                  budget;
+    uint8_t                   priority;
+    uint8_t                   last_pass;
+    bool                      job_missed;
+    task_scheduler_stats_t    stats;
+} task_scheduler_task_t;
+
+static task_scheduler_task_t tasks[TASK_SCHEDULER_MAX_TASKS];
+static uint8_t               current_pass = 0;
+
+static inline task_scheduler_task_t *task_from_token(task_scheduler_token token) {
+    if (token == INVALID_TASK_SCHEDULER_TOKEN || token > TASK_SCHEDULER_MAX_TASKS || !tasks[token - 1].callback) {
+        return NULL;
+    }
+    return &tasks[token - 1];
+}
+
+static inline uint16_t task_deadline(const task_scheduler_task_t *task) {
+    return task->period ? task->period : TASK_SCHEDULER_STARVATION_LIMIT;
+}
+
+task_scheduler_token task_scheduler_register(task_scheduler_callback_t callback, const char *name, uint16_t period_ms, uint8_t priority, uint16_t budget_ms) {
+    if (!callback) {
+        return INVALID_TASK_SCHEDULER_TOKEN;
+    }
+
+    // Find an unused slot and claim it
+    for (uint8_t i = 0; i < TASK_SCHEDULER_MAX_TASKS; ++i) {
+        task_scheduler_task_t *task = &tasks[i];
+        if (!task->callback) {
+            *task = (task_scheduler_task_t){
+                .callback  = callback,
+                .name      = name ? name : "?",
+                .due_time  = timer_read32(),
+                .period    = period_ms,
+                .budget    = budget_ms,
+                .priority  = priority,
+                .last_pass = current_pass,
+            };
+            // Make the task eligible on the next pass, even if that is the current one
+            task->last_pass--;
+            return i + 1;
+        }
+    }
+
+    // None available
+    return INVALID_TASK_SCHEDULER_TOKEN;
+}
+
+bool task_scheduler_unregister(task_scheduler_token token) {
+    task_scheduler_task_t *task = task_from_token(token);
+    if (!task) {
+        return false;
+    }
+    task->callback = NULL;
+    return true;
+}
+
+const task_scheduler_stats_t *task_scheduler_get_stats(task_scheduler_token token) {
+    task_scheduler_task_t *task = task_from_token(token);
+    return task ? &task->stats : NULL;
+}
+
+void task_scheduler_reset_stats(void) {
+    for (uint8_t i = 0; i < TASK_SCHEDULER_MAX_TASKS; ++i) {
+        tasks[i].stats = (task_scheduler_stats_t){0};
+    }
+}
+
+// Picks the most urgent due task that has not run on this pass yet: missed
+// deadlines first, then the highest priority, then the one due the longest.
+static task_scheduler_task_t *next_task(uint32_t now) {
+    task_scheduler_task_t *best        = NULL;
+    uint32_t               best_late   = 0;
+    bool                   best_missed = false;
+
+    for (uint8_t i = 0; i < TASK_SCHEDULER_MAX_TASKS; ++i) {
+        task_scheduler_task_t *task = &tasks[i];
+        if (!task->callback || task->last_pass == current_pass) {
+            continue;
+        }
+
+        if (!timer_expired32(now, task->due_time)) {
+            // Due further away than a whole period can only mean the timer was reset
+            if (TIMER_DIFF_32(task->due_time, now) <= task->period) {
+                continue;
+            }
+            task->due_time = now;
+        }
+
+        uint32_t late   = TIMER_DIFF_32(now, task->due_time);
+        bool     missed = late > task_deadline(task);
+        if (best) {
+            if (missed != best_missed) {
+                if (!missed) continue;
+            } else if (task->priority != best->priority) {
+                if (task->priority < best->priority) continue;
+            } else if (late <= best_late) {
+                continue;
+            }
+        }
+        best        = task;
+        best_late   = late;
+        best_missed = missed;
+    }
+
+    return best;
+}
+
+static void run_task(task_scheduler_task_t *task, uint32_t start) {
+    uint32_t late = TIMER_DIFF_32(start, task->due_time);
+    if (late > task->stats.max_lateness) {
+        task->stats.max_lateness = late > UINT16_MAX ? UINT16_MAX : late;
+    }
+    if (late > task_deadline(task) && !task->job_missed) {
+        task->job_missed = true;
+        if (task->stats.deadline_misses < UINT16_MAX) {
+            task->stats.deadline_misses++;
+        }
+        dprintf("task_scheduler: %s started %lums late\n", task->name, late);
+    }
+
+    task->last_pass      = current_pass;
+    bool     pending     = task->callback();
+    uint32_t duration    = timer_elapsed32(start);
+    task->stats.runs++;
+    if (duration > task->stats.max_duration) {
+        task->stats.max_duration = duration > UINT16_MAX ? UINT16_MAX : duration;
+    }
+    if (task->budget && duration > task->budget) {
+        if (task->stats.budget_overruns < UINT16_MAX) {
+            task->stats.budget_overruns++;
+        }
+        dprintf("task_scheduler: %s took %lums of its %ums budget\n", task->name, duration, task->budget);
+    }
+
+    // The callback may have unregistered itself
+    if (!task->callback || pending) {
+        return;
+    }
+
+    // Job done, schedule the next period without trying to catch up on skipped ones
+    uint32_t now     = timer_read32();
+    task->job_missed = false;
+    task->due_time += task->period;
+    if (timer_expired32(now, task->due_time)) {
+        task->due_time = now;
+    }
+}
+
+void task_scheduler_run(void) {
+    uint32_t pass_start = timer_read32();
+    current_pass++;
+
+    // Always run the most urgent task, then keep going while the loop budget allows
+    do {
+        uint32_t               now  = timer_read32();
+        task_scheduler_task_t *task = next_task(now);
+        if (!task) {
+            break;
+        }
+        run_task(task, now);
+    } while (timer_elapsed32(pass_start) < TASK_SCHEDULER_LOOP_BUDGET);
+}
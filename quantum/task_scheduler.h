@@ -0,0 +1,116 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+    Cooperative scheduler for the background tasks of keyboard_task().
+
+    The matrix scan, quantum_task() and the input devices are always serviced
+    first on every pass of the main loop. Everything else (lighting, displays,
+    mousekeys, host LED state, ...) is registered as a task with a period, a
+    priority and a time budget, and task_scheduler_run() then dispatches the
+    due tasks until the loop budget is used up. At least one task runs per
+    pass, so a slow task can delay the next matrix scan by at most its own
+    duration plus TASK_SCHEDULER_LOOP_BUDGET.
+
+    Tasks are plain functions. Returning true tells the scheduler that the
+    task has more work pending and wants to be resumed on a later pass, before
+    its next period starts. Long jobs split themselves into slices this way,
+    keeping their progress in their own static state.
+
+    A task misses its deadline when it starts later than one period after it
+    became due, or later than TASK_SCHEDULER_STARVATION_LIMIT for tasks that
+    run on every pass. Missed tasks are dispatched ahead of everything else.
+    Misses and budget overruns are counted per task and printed over console
+    while debug is enabled.
+*/
+
+#ifndef TASK_SCHEDULER_MAX_TASKS
+#    define TASK_SCHEDULER_MAX_TASKS 24
+#endif
+
+#ifndef TASK_SCHEDULER_LOOP_BUDGET
+#    define TASK_SCHEDULER_LOOP_BUDGET 1
+#endif
+
+#ifndef TASK_SCHEDULER_STARVATION_LIMIT
+#    define TASK_SCHEDULER_STARVATION_LIMIT 10
+#endif
+
+#ifndef TASK_SCHEDULER_DEFAULT_BUDGET
+#    define TASK_SCHEDULER_DEFAULT_BUDGET 2
+#endif
+
+/**
+ * @typedef Opaque handle to a registered task.
+ */
+typedef uint8_t task_scheduler_token;
+
+/**
+ * @def Value used to signify an invalid task handle.
+ */
+#define INVALID_TASK_SCHEDULER_TOKEN 0
+
+/**
+ * @brief Suggested task priorities, higher values are dispatched first.
+ */
+enum task_scheduler_priority {
+    TASK_SCHEDULER_PRIORITY_IDLE   = 0,
+    TASK_SCHEDULER_PRIORITY_LOW    = 64,
+    TASK_SCHEDULER_PRIORITY_NORMAL = 128,
+    TASK_SCHEDULER_PRIORITY_HIGH   = 192,
+};
+
+/**
+ * @typedef Task callback, returns true if it has more work pending and wants to be resumed as soon as possible.
+ */
+typedef bool (*task_scheduler_callback_t)(void);
+
+/**
+ * @brief Statistics of one task, all durations in milliseconds.
+ */
+typedef struct task_scheduler_stats_t {
+    uint32_t runs;
+    uint16_t deadline_misses;
+    uint16_t budget_overruns;
+    uint16_t max_lateness;
+    uint16_t max_duration;
+} task_scheduler_stats_t;
+
+/**
+ * @brief Registers a task.
+ *
+ * @param callback[in] the task to invoke
+ * @param name[in] the name used when reporting the task, may be NULL
+ * @param period_ms[in] the time between two runs of the task, 0 to run it on every pass of the main loop
+ * @param priority[in] the priority of the task, see enum task_scheduler_priority
+ * @param budget_ms[in] the time a single run may take before it counts as an overrun, 0 for no limit
+ * @return a token usable for unregistration, or INVALID_TASK_SCHEDULER_TOKEN if the table is full
+ */
+task_scheduler_token task_scheduler_register(task_scheduler_callback_t callback, const char *name, uint16_t period_ms, uint8_t priority, uint16_t budget_ms);
+
+/**
+ * @brief Removes a registered task.
+ *
+ * @return true if the token referred to a registered task
+ */
+bool task_scheduler_unregister(task_scheduler_token token);
+
+/**
+ * @brief Returns the statistics of a task, or NULL if the token is invalid.
+ */
+const task_scheduler_stats_t *task_scheduler_get_stats(task_scheduler_token token);
+
+/**
+ * @brief Clears the statistics of all tasks.
+ */
+void task_scheduler_reset_stats(void);
+
+/**
+ * @brief Runs the due tasks until the loop budget is used up. Called from keyboard_task().
+ */
+void task_scheduler_run(void);
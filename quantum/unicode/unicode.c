@@ -332,9 +332,13 @@ void register_hex(uint16_t hex) {
     }
 }
 
-void register_hex32(uint32_t hex) {
-    bool first_digit        = true;
-    bool needs_leading_zero = (unicode_config.input_mode == UNICODE_MODE_WINCOMPOSE);
+// Longest digit sequence for one code point: a surrogate pair, or eight digits and a leading zero
+#define CODE_POINT_MAX_DIGITS 9
+
+static uint8_t encode_hex32(uint32_t hex, uint8_t *digits) {
+    uint8_t count              = 0;
+    bool    first_digit        = true;
+    bool    needs_leading_zero = (unicode_config.input_mode == UNICODE_MODE_WINCOMPOSE);
     for (int i = 7; i >= 0; i--) {
         // Work out the digit we're going to transmit
         uint8_t digit = ((hex >> (i * 4)) & 0xF);
@@ -342,7 +346,7 @@ void register_hex32(uint32_t hex) {
         // If we're still searching for the first digit, and found one
         // that needs a leading zero sent out, send the zero.
         if (first_digit && needs_leading_zero && digit > 9) {
-            send_nibble_wrapper(0);
+            digits[count++] = 0;
         }
 
         // Always send digits (including zero) if we're down to the last
@@ -351,28 +355,52 @@ void register_hex32(uint32_t hex) {
 
         // If we've found a digit worth transmitting, do so.
         if (digit != 0 || !first_digit || must_send) {
-            send_nibble_wrapper(digit);
-            first_digit = false;
+            digits[count++] = digit;
+            first_digit     = false;
         }
     }
+    return count;
 }
 
-void register_unicode(uint32_t code_point) {
+/* Works out the digits to type for a code point before anything is sent, or
+ * returns 0 if it cannot be input in the current mode.
+ */
+static uint8_t encode_code_point(uint32_t code_point, uint8_t *digits) {
     if (code_point > 0x10FFFF || (code_point > 0xFFFF && unicode_config.input_mode == UNICODE_MODE_WINDOWS)) {
         // Code point out of range, do nothing
-        return;
+        return 0;
     }
 
-    unicode_input_start();
     if (code_point > 0xFFFF && unicode_config.input_mode == UNICODE_MODE_MACOS) {
         // Convert code point to UTF-16 surrogate pair on macOS
         code_point -= 0x10000;
         uint32_t lo = code_point & 0x3FF, hi = (code_point & 0xFFC00) >> 10;
-        register_hex32(hi + 0xD800);
-        register_hex32(lo + 0xDC00);
-    } else {
-        register_hex32(code_point);
+        uint8_t  count = encode_hex32(hi + 0xD800, digits);
+        return count + encode_hex32(lo + 0xDC00, digits + count);
+    }
+    return encode_hex32(code_point, digits);
+}
+
+static void send_digits(const uint8_t *digits, uint8_t count) {
+    for (uint8_t i = 0; i < count; i++) {
+        send_nibble_wrapper(digits[i]);
+    }
+}
+
+void register_hex32(uint32_t hex) {
+    uint8_t digits[CODE_POINT_MAX_DIGITS];
+    send_digits(digits, encode_hex32(hex, digits));
+}
+
+void register_unicode(uint32_t code_point) {
+    uint8_t digits[CODE_POINT_MAX_DIGITS];
+    uint8_t count = encode_code_point(code_point, digits);
+    if (!count) {
+        return;
     }
+
+    unicode_input_start();
+    send_digits(digits, count);
     unicode_input_finish();
 }
 
@@ -381,12 +409,37 @@ void send_unicode_string(const char *str) {
         return;
     }
 
+    // macOS Unicode Hex Input commits a character for every four digits typed
+    // while the key is held, so the whole string goes into one input there.
+    // The other modes commit the code point when the input is finished.
+    bool keep_input = unicode_config.input_mode == UNICODE_MODE_MACOS;
+    bool in_input   = false;
+
     while (*str) {
         int32_t code_point = 0;
         str                = decode_utf8(str, &code_point);
+        if (code_point < 0) {
+            continue;
+        }
+
+        uint8_t digits[CODE_POINT_MAX_DIGITS];
+        uint8_t count = encode_code_point(code_point, digits);
+        if (!count) {
+            continue;
+        }
 
-        if (code_point >= 0) {
-            register_unicode(code_point);
+        if (!in_input) {
+            unicode_input_start();
+            in_input = true;
         }
+        send_digits(digits, count);
+        if (!keep_input) {
+            unicode_input_finish();
+            in_input = false;
+        }
+    }
+
+    if (in_input) {
+        unicode_input_finish();
     }
 }
@@ -57,6 +57,10 @@
 #    include "led_matrix.h"
 #endif
 
+#if defined(TASK_PROFILER_ENABLE)
+#    include "task_profiler.h"
+#endif
+
 // Can be called in an overriding via_init_kb() to test if keyboard level code usage of
 // EEPROM is invalid and use/save defaults.
 bool via_eeprom_is_valid(void) {
@@ -286,6 +290,12 @@ void raw_hid_receive(uint8_t *data, uint8_t length) {
         return;
     }
 
+#ifdef TASK_PROFILER_ENABLE
+    if (task_profiler_raw_hid_receive(data, length)) {
+        return;
+    }
+#endif
+
     switch (*command_id) {
         case id_get_protocol_version: {
             command_data[0] = VIA_PROTOCOL_VERSION >> 8;
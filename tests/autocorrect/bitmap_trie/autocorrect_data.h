@@ -0,0 +1,235 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/*******************************************************************************
+  88888888888 888      d8b                .d888 d8b 888               d8b
+      888     888      Y8P               d88P"  Y8P 888               Y8P
+      888     888                        888        888
+      888     88888b.  888 .d8888b       888888 888 888  .d88b.       888 .d8888b
+      888     888 "88b 888 88K           888    888 888 d8P  Y8b      888 88K
+      888     888  888 888 "Y8888b.      888    888 888 88888888      888 "Y8888b.
+      888     888  888 888      X88      888    888 888 Y8b.          888      X88
+      888     888  888 888  88888P'      888    888 888  "Y8888       888  88888P'
+                                                        888                 888
+                                                        888                 888
+                                                        888                 888
+     .d88b.   .d88b.  88888b.   .d88b.  888d888 8888b.  888888 .d88b.   .d88888
+    d88P"88b d8P  Y8b 888 "88b d8P  Y8b 888P"      "88b 888   d8P  Y8b d88" 888
+    888  888 88888888 888  888 88888888 888    .d888888 888   88888888 888  888
+    Y88b 888 Y8b.     888  888 Y8b.     888    888  888 Y88b. Y8b.     Y88b 888
+     "Y88888  "Y8888  888  888  "Y8888  888    "Y888888  "Y888 "Y8888   "Y88888
+         888
+    Y8b d88P
+     "Y88P"
+*******************************************************************************/
+
+#pragma once
+
+// Autocorrection dictionary (70 entries):
+//   :guage     -> gauge
+//   :the:the:  -> the
+//   :thier     -> their
+//   :ture      -> true
+//   accomodate -> accommodate
+//   acommodate -> accommodate
+//   aparent    -> apparent
+//   aparrent   -> apparent
+//   apparant   -> apparent
+//   apparrent  -> apparent
+//   aquire     -> acquire
+//   becuase    -> because
+//   cauhgt     -> caught
+//   cheif      -> chief
+//   choosen    -> chosen
+//   cieling    -> ceiling
+//   collegue   -> colleague
+//   concensus  -> consensus
+//   contians   -> contains
+//   cosnt      -> const
+//   dervied    -> derived
+//   fales      -> false
+//   fasle      -> false
+//   fitler     -> filter
+//   flase      -> false
+//   foward     -> forward
+//   frequecy   -> frequency
+//   gaurantee  -> guarantee
+//   guaratee   -> guarantee
+//   heigth     -> height
+//   heirarchy  -> hierarchy
+//   inclued    -> include
+//   interator  -> iterator
+//   intput     -> input
+//   invliad    -> invalid
+//   lenght     -> length
+//   liasion    -> liaison
+//   libary     -> library
+//   listner    -> listener
+//   looses:    -> loses
+//   looup      -> lookup
+//   manefist   -> manifest
+//   namesapce  -> namespace
+//   namespcae  -> namespace
+//   occassion  -> occasion
+//   occured    -> occurred
+//   ouptut     -> output
+//   ouput      -> output
+//   overide    -> override
+//   postion    -> position
+//   priviledge -> privilege
+//   psuedo     -> pseudo
+//   recieve    -> receive
+//   refered    -> referred
+//   relevent   -> relevant
+//   repitition -> repetition
+//   retrun     -> return
+//   retun      -> return
+//   reuslt     -> result
+//   reutrn     -> return
+//   saftey     -> safety
+//   seperate   -> separate
+//   singed     -> signed
+//   stirng     -> string
+//   strign     -> string
+//   swithc     -> switch
+//   swtich     -> switch
+//   thresold   -> threshold
+//   udpate     -> update
+//   widht      -> width
+
+#define AUTOCORRECT_MIN_LENGTH 5 // ":ture"
+#define AUTOCORRECT_MAX_LENGTH 10 // "accomodate"
+#define AUTOCORRECT_MAX_CORRECTION_LENGTH 9
+#define AUTOCORRECT_BITMAP_TRIE
+#define AUTOCORRECT_TRIE_NODES 384
+#define AUTOCORRECT_CORRECTIONS_SIZE 414
+
+#ifndef AUTOCORRECT_FLASH_OFFSET
+static const uint32_t autocorrect_trie[AUTOCORRECT_TRIE_NODES * 2] PROGMEM = {
+    0x090EE0FC, 0x00000001, 0x00000080, 0x0000000F, 0x00020811, 0x00000010, 0x003E085D, 0x00000014,
+    0x00000100, 0x0000001F, 0x00002000, 0x00000020, 0x00080004, 0x00000021, 0x00124050, 0x00000023,
+    0x00000008, 0x00000028, 0x00100000, 0x00000029, 0x00004010, 0x0000002A, 0x00102010, 0x0000002C,
+    0x001428C0, 0x0000002F, 0x00020094, 0x00000035, 0x00040010, 0x00000039, 0x00080000, 0x0000003B,
+    0x00000100, 0x0000003C, 0x00120140, 0x0000003D, 0x00004000, 0x00000041, 0x00000001, 0x00000042,
+    0x00000004, 0x00000043, 0x00008000, 0x00000044, 0x00000100, 0x00000045, 0x00080000, 0x00000046,
+    0x00000009, 0x00000047, 0x00040000, 0x00000049, 0x00100100, 0x0000004A, 0x00000001, 0x0000004C,
+    0x00000001, 0x0000004D, 0x00000040, 0x0000004E, 0x00000010, 0x0000004F, 0x00000010, 0x00000050,
+    0x00020100, 0x00000051, 0x00000100, 0x00000053, 0x00000040, 0x00000054, 0x00040000, 0x00000055,
+    0x00000100, 0x00000056, 0x00000100, 0x00000057, 0x00080000, 0x00000058, 0x000A0000, 0x00000059,
+    0x00000010, 0x0000005B, 0x00004000, 0x0000005C, 0x00002900, 0x0000005D, 0x00080000, 0x00000060,
+    0x00000800, 0x00000061, 0x00000001, 0x00000062, 0x00040000, 0x00000063, 0x00000080, 0x00000064,
+    0x00000048, 0x00000065, 0x00040000, 0x00000067, 0x00040011, 0x00000068, 0x00000100, 0x0000006B,
+    0x00088000, 0x0000006C, 0x00000010, 0x0000006E, 0x00080000, 0x0000006F, 0x00000004, 0x00000070,
+    0x00000001, 0x00000071, 0x00000080, 0x00000072, 0x00000010, 0x00000073, 0x00000100, 0x00000074,
+    0x00000800, 0x00000075, 0x00002000, 0x00000076, 0x00200000, 0x00000077, 0x00100010, 0x00000078,
+    0x00000800, 0x0000007A, 0x00040000, 0x0000007B, 0x00400000, 0x0000007C, 0x00008000, 0x0000007D,
+    0x00000001, 0x0000007E, 0x00020000, 0x0000007F, 0x00002001, 0x00000080, 0x00100000, 0x00000082,
+    0x00000010, 0x00000083, 0x00000001, 0x00000084, 0x00100000, 0x00000085, 0x00080000, 0x00000086,
+    0x00100800, 0x00000087, 0x00028008, 0x00000089, 0x00000010, 0x0000008C, 0x00000100, 0x0000008D,
+    0x00000080, 0x0000008E, 0x00000800, 0x0000008F, 0x00000100, 0x00000090, 0x00080000, 0x00000091,
+    0x00000100, 0x00000092, 0x00004000, 0x00000093, 0x00020000, 0x00000094, 0x000C0000, 0x00000095,
+    0x00100000, 0x00000097, 0x00080000, 0x00000098, 0x00000010, 0x00000099, 0x00100000, 0x0000009A,
+    0x00004000, 0x0000009B, 0x00000080, 0x0000009C, 0x00080000, 0x0000009D, 0x00080000, 0x0000009E,
+    0x00000001, 0x0000009F, 0x00000001, 0x000000A0, 0x00000100, 0x000000A1, 0x00002000, 0x000000A2,
+    0x00100000, 0x000000A3, 0x00000100, 0x000000A4, 0x00002000, 0x000000A5, 0x00100000, 0x000000A6,
+    0x00020000, 0x000000A7, 0x00220000, 0x000000A8, 0x00004000, 0x000000AA, 0x00000020, 0x000000AB,
+    0x00180000, 0x000000AC, 0x00008000, 0x000000AE, 0x00100000, 0x000000AF, 0x00000020, 0x000000B0,
+    0x00020000, 0x000000B1, 0x00000002, 0x000000B2, 0x00080000, 0x000000B3, 0x00040000, 0x000000B4,
+    0x00400000, 0x000000B5, 0x00200000, 0x000000B6, 0x00000100, 0x000000B7, 0x00020000, 0x000000B8,
+    0x00000020, 0x000000B9, 0x00000004, 0x000000BA, 0x00000004, 0x000000BB, 0x00000010, 0x000000BC,
+    0x00004000, 0x000000BD, 0x00040000, 0x000000BE, 0x00040000, 0x000000BF, 0x00000010, 0x000000C0,
+    0x00020000, 0x000000C1, 0x00000001, 0x000000C2, 0x00000040, 0x000000C3, 0x00000800, 0x000000C4,
+    0x00000020, 0x000000C5, 0x00010000, 0x000000C6, 0x08000000, 0x000000C7, 0x00000020, 0x000000C8,
+    0x00000004, 0x000000C9, 0x00004000, 0x000000CA, 0x00000008, 0x000000CB, 0x00000010, 0x000000CC,
+    0x00000800, 0x000000CD, 0x00000004, 0x000000CE, 0x00000004, 0x000000CF, 0x00000010, 0x000000D0,
+    0x00080000, 0x000000D1, 0x00400000, 0x000000D2, 0x00000010, 0x000000D3, 0x00004000, 0x000000D4,
+    0x00080000, 0x000000D5, 0x00040001, 0x000000D6, 0x00040100, 0x000000D8, 0x00000010, 0x000000DA,
+    0x00000010, 0x000000DB, 0x00020000, 0x000000DC, 0x00040000, 0x000000DD, 0x00000800, 0x000000DE,
+    0x00080000, 0x000000DF, 0x00000100, 0x000000E0, 0x00040000, 0x000000E1, 0x00020000, 0x000000E2,
+    0x00000020, 0x000000E3, 0x00080000, 0x000000E4, 0x00000010, 0x000000E5, 0x00000001, 0x000000E6,
+    0x00400000, 0x000000E7, 0x00000010, 0x000000E8, 0x00000010, 0x000000E9, 0x00000001, 0x000000EA,
+    0x00020001, 0x000000EB, 0x00000010, 0x000000ED, 0x00000004, 0x000000EE, 0x00000010, 0x000000EF,
+    0x00002000, 0x000000F0, 0x00004000, 0x000000F1, 0x00100000, 0x000000F2, 0x00010000, 0x000000F3,
+    0x00000001, 0x000000F4, 0x00000001, 0x000000F5, 0x00000100, 0x000000F6, 0x08000000, 0x000000F7,
+    0x00004000, 0x000000F8, 0x00040000, 0x000000F9, 0x00002000, 0x000000FA, 0x00040000, 0x000000FB,
+    0x00000010, 0x000000FC, 0x00000010, 0x000000FD, 0x00000004, 0x000000FE, 0x00002000, 0x000000FF,
+    0x00020000, 0x00000100, 0x00000020, 0x00000101, 0x00000010, 0x00000102, 0x00000010, 0x00000103,
+    0x00200000, 0x00000104, 0x00000001, 0x00000105, 0x00020000, 0x00000106, 0x08000000, 0x00000107,
+    0x00000100, 0x00000108, 0x80000000, 0x00000000, 0x00000001, 0x00000109, 0x80000000, 0x00000005,
+    0x80000000, 0x0000000A, 0x00000010, 0x0000010A, 0x00001000, 0x0000010B, 0x00100000, 0x0000010C,
+    0x00008000, 0x0000010D, 0x00000800, 0x0000010E, 0x00000010, 0x0000010F, 0x80000000, 0x00000010,
+    0x00000100, 0x00000110, 0x00040000, 0x00000111, 0x00040000, 0x00000112, 0x00000080, 0x00000113,
+    0x00000080, 0x00000114, 0x00040000, 0x00000115, 0x00000100, 0x00000116, 0x00000001, 0x00000117,
+    0x00080000, 0x00000118, 0x00004000, 0x00000119, 0x00020000, 0x0000011A, 0x00020000, 0x0000011B,
+    0x80000000, 0x00000015, 0x00008000, 0x0000011C, 0x80000000, 0x00000019, 0x08000000, 0x0000011D,
+    0x00000020, 0x0000011E, 0x00000100, 0x0000011F, 0x00000010, 0x00000120, 0x80000000, 0x0000001E,
+    0x00002000, 0x00000121, 0x00000004, 0x00000122, 0x00000004, 0x00000123, 0x80000000, 0x00000022,
+    0x00000800, 0x00000124, 0x00020000, 0x00000125, 0x00008000, 0x00000126, 0x00008000, 0x00000127,
+    0x00000001, 0x00000128, 0x00000800, 0x00000129, 0x80000000, 0x00000026, 0x00002000, 0x0000012A,
+    0x00000100, 0x0000012B, 0x80000000, 0x0000002B, 0x00004000, 0x0000012C, 0x00000010, 0x0000012D,
+    0x00040000, 0x0000012E, 0x00020000, 0x0000012F, 0x00000800, 0x00000130, 0x00000010, 0x00000131,
+    0x00004000, 0x00000132, 0x80000000, 0x00000031, 0x00000100, 0x00000133, 0x80000000, 0x00000035,
+    0x00000008, 0x00000134, 0x00020000, 0x00000135, 0x00004000, 0x00000136, 0x00000100, 0x00000137,
+    0x00000080, 0x00000138, 0x80000000, 0x0000003B, 0x00001000, 0x00000139, 0x00001000, 0x0000013A,
+    0x00004000, 0x0000013B, 0x00100000, 0x0000013C, 0x00100000, 0x0000013D, 0x80000000, 0x00000042,
+    0x00200000, 0x0000013E, 0x80000000, 0x00000048, 0x00000002, 0x0000013F, 0x00005000, 0x00000140,
+    0x80000000, 0x00000050, 0x00000010, 0x00000142, 0x00004000, 0x00000143, 0x00020000, 0x00000144,
+    0x00000004, 0x00000145, 0x80000000, 0x00000057, 0x80000000, 0x0000005D, 0x80000000, 0x00000063,
+    0x00000004, 0x00000146, 0x80000000, 0x00000067, 0x00000800, 0x00000147, 0x00000004, 0x00000148,
+    0x00000100, 0x00000149, 0x00008000, 0x0000014A, 0x80000000, 0x0000006B, 0x80000000, 0x00000071,
+    0x80000000, 0x00000076, 0x80000000, 0x0000007C, 0x80000000, 0x00000081, 0x00000800, 0x0000014B,
+    0x00080000, 0x0000014C, 0x00004000, 0x0000014D, 0x00002000, 0x0000014E, 0x80000000, 0x00000087,
+    0x80000000, 0x0000008C, 0x80000000, 0x00000090, 0x00008000, 0x0000014F, 0x00000001, 0x00000150,
+    0x00008000, 0x00000151, 0x00000010, 0x00000152, 0x00000001, 0x00000153, 0x80000000, 0x00000096,
+    0x80000000, 0x0000009B, 0x00020000, 0x00000154, 0x80000000, 0x000000A1, 0x00000100, 0x00000155,
+    0x80000000, 0x000000A6, 0x00000080, 0x00000156, 0x00000800, 0x00000157, 0x80000000, 0x000000AC,
+    0x80000000, 0x000000B2, 0x80000000, 0x000000B8, 0x80000000, 0x000000BD, 0x80000000, 0x000000C2,
+    0x00080000, 0x00000158, 0x00000001, 0x00000159, 0x00000001, 0x0000015A, 0x80000000, 0x000000C6,
+    0x00000040, 0x0000015B, 0x00000001, 0x0000015C, 0x00000100, 0x0000015D, 0x80000000, 0x000000CC,
+    0x00004000, 0x0000015E, 0x00000004, 0x0000015F, 0x00040000, 0x00000160, 0x00000004, 0x00000161,
+    0x80000000, 0x000000D2, 0x80000000, 0x000000D8, 0x80000000, 0x000000E0, 0x80000000, 0x000000E5,
+    0x00000004, 0x00000162, 0x00008000, 0x00000163, 0x80000000, 0x000000EB, 0x80000000, 0x000000F2,
+    0x00002000, 0x00000164, 0x00000004, 0x00000165, 0x00004000, 0x00000166, 0x00000001, 0x00000167,
+    0x80000000, 0x000000F8, 0x00008001, 0x00000168, 0x00020000, 0x0000016A, 0x00001000, 0x0000016B,
+    0x00000020, 0x0000016C, 0x00000010, 0x0000016D, 0x00080000, 0x0000016E, 0x80000000, 0x00000100,
+    0x80000000, 0x00000105, 0x00002000, 0x0000016F, 0x00002000, 0x00000170, 0x80000000, 0x0000010B,
+    0x00000040, 0x00000171, 0x00020000, 0x00000172, 0x00000004, 0x00000173, 0x00000004, 0x00000174,
+    0x80000000, 0x00000111, 0x80000000, 0x00000118, 0x00004000, 0x00000175, 0x00000010, 0x00000176,
+    0x00000100, 0x00000177, 0x80000000, 0x0000011E, 0x00000004, 0x00000178, 0x80000000, 0x00000124,
+    0x80000000, 0x00000129, 0x00000001, 0x00000179, 0x80000000, 0x00000131, 0x80000000, 0x00000136,
+    0x80000000, 0x0000013D, 0x00000080, 0x0000017A, 0x08000000, 0x0000017B, 0x80000000, 0x00000142,
+    0x80000000, 0x00000147, 0x80000000, 0x0000014D, 0x00008000, 0x0000017C, 0x00000001, 0x0000017D,
+    0x00000001, 0x0000017E, 0x80000000, 0x00000157, 0x00020000, 0x0000017F, 0x80000000, 0x0000015C,
+    0x80000000, 0x00000165, 0x80000000, 0x0000016D, 0x80000000, 0x00000172, 0x80000000, 0x0000017C,
+    0x80000000, 0x0000017E, 0x80000000, 0x00000182, 0x80000000, 0x0000018D, 0x80000000, 0x00000195
+};
+
+static const uint8_t autocorrect_corrections[AUTOCORRECT_CORRECTIONS_SIZE] PROGMEM = {
+    0x02, 0x6C, 0x73, 0x65, 0x00, 0x02, 0x72, 0x75, 0x65, 0x00, 0x03, 0x61, 0x6C, 0x73, 0x65, 0x00,
+    0x02, 0x69, 0x65, 0x66, 0x00, 0x00, 0x72, 0x6E, 0x00, 0x01, 0x6B, 0x75, 0x70, 0x00, 0x01, 0x73,
+    0x65, 0x00, 0x01, 0x74, 0x68, 0x00, 0x02, 0x6E, 0x73, 0x74, 0x00, 0x02, 0x74, 0x70, 0x75, 0x74,
+    0x00, 0x01, 0x63, 0x68, 0x00, 0x03, 0x67, 0x6E, 0x65, 0x64, 0x00, 0x03, 0x72, 0x77, 0x61, 0x72,
+    0x64, 0x00, 0x03, 0x61, 0x75, 0x67, 0x65, 0x00, 0x04, 0x63, 0x71, 0x75, 0x69, 0x72, 0x65, 0x00,
+    0x04, 0x70, 0x64, 0x61, 0x74, 0x65, 0x00, 0x03, 0x72, 0x69, 0x6E, 0x67, 0x00, 0x03, 0x69, 0x74,
+    0x63, 0x68, 0x00, 0x01, 0x68, 0x74, 0x00, 0x01, 0x6E, 0x67, 0x00, 0x03, 0x74, 0x75, 0x72, 0x6E,
+    0x00, 0x02, 0x75, 0x72, 0x6E, 0x00, 0x03, 0x65, 0x75, 0x64, 0x6F, 0x00, 0x02, 0x65, 0x69, 0x72,
+    0x00, 0x03, 0x6C, 0x74, 0x65, 0x72, 0x00, 0x02, 0x67, 0x68, 0x74, 0x00, 0x01, 0x74, 0x68, 0x00,
+    0x03, 0x73, 0x75, 0x6C, 0x74, 0x00, 0x03, 0x70, 0x75, 0x74, 0x00, 0x03, 0x74, 0x70, 0x75, 0x74,
+    0x00, 0x02, 0x65, 0x74, 0x79, 0x00, 0x02, 0x72, 0x61, 0x72, 0x79, 0x00, 0x03, 0x61, 0x6C, 0x69,
+    0x64, 0x00, 0x03, 0x69, 0x76, 0x65, 0x64, 0x00, 0x01, 0x72, 0x65, 0x64, 0x00, 0x01, 0x72, 0x65,
+    0x64, 0x00, 0x01, 0x64, 0x65, 0x00, 0x02, 0x72, 0x69, 0x64, 0x65, 0x00, 0x03, 0x61, 0x75, 0x73,
+    0x65, 0x00, 0x03, 0x65, 0x69, 0x76, 0x65, 0x00, 0x05, 0x65, 0x69, 0x6C, 0x69, 0x6E, 0x67, 0x00,
+    0x03, 0x73, 0x65, 0x6E, 0x00, 0x03, 0x69, 0x73, 0x6F, 0x6E, 0x00, 0x03, 0x69, 0x74, 0x69, 0x6F,
+    0x6E, 0x00, 0x02, 0x65, 0x6E, 0x65, 0x72, 0x00, 0x04, 0x70, 0x61, 0x72, 0x65, 0x6E, 0x74, 0x00,
+    0x04, 0x73, 0x65, 0x73, 0x00, 0x02, 0x68, 0x6F, 0x6C, 0x64, 0x00, 0x02, 0x6E, 0x74, 0x65, 0x65,
+    0x00, 0x04, 0x61, 0x72, 0x61, 0x74, 0x65, 0x00, 0x02, 0x61, 0x67, 0x75, 0x65, 0x00, 0x03, 0x61,
+    0x69, 0x6E, 0x73, 0x00, 0x02, 0x65, 0x6E, 0x74, 0x00, 0x05, 0x70, 0x61, 0x72, 0x65, 0x6E, 0x74,
+    0x00, 0x02, 0x61, 0x6E, 0x74, 0x00, 0x04, 0x69, 0x66, 0x65, 0x73, 0x74, 0x00, 0x01, 0x6E, 0x63,
+    0x79, 0x00, 0x02, 0x61, 0x63, 0x65, 0x00, 0x03, 0x70, 0x61, 0x63, 0x65, 0x00, 0x07, 0x75, 0x61,
+    0x72, 0x61, 0x6E, 0x74, 0x65, 0x65, 0x00, 0x03, 0x69, 0x6F, 0x6E, 0x00, 0x07, 0x74, 0x65, 0x72,
+    0x61, 0x74, 0x6F, 0x72, 0x00, 0x05, 0x73, 0x65, 0x6E, 0x73, 0x75, 0x73, 0x00, 0x03, 0x65, 0x6E,
+    0x74, 0x00, 0x07, 0x69, 0x65, 0x72, 0x61, 0x72, 0x63, 0x68, 0x79, 0x00, 0x04, 0x00, 0x02, 0x67,
+    0x65, 0x00, 0x07, 0x63, 0x6F, 0x6D, 0x6D, 0x6F, 0x64, 0x61, 0x74, 0x65, 0x00, 0x04, 0x6D, 0x6F,
+    0x64, 0x61, 0x74, 0x65, 0x00, 0x06, 0x65, 0x74, 0x69, 0x74, 0x69, 0x6F, 0x6E, 0x00
+};
+#endif
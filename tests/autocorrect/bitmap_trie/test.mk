@@ -0,0 +1,12 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+# --------------------------------------------------------------------------------
+# Keep this file, even if it is empty, as a marker that this folder contains tests
+# --------------------------------------------------------------------------------
+
+AUTOCORRECT_ENABLE = yes
+
+# Run the regular autocorrect tests against the default dictionary, generated
+# with `qmk generate-autocorrect-data --format bitmap` into autocorrect_data.h
+SRC += ../test_autocorrect.cpp
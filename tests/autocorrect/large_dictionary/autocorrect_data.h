@@ -0,0 +1,15 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+// The defines `qmk generate-autocorrect-data --format bitmap` emits for the
+// 10000 entry dictionary of test_large_dictionary.cpp. The trie itself lives
+// in external flash, so no arrays are compiled in.
+
+#define AUTOCORRECT_MIN_LENGTH 8
+#define AUTOCORRECT_MAX_LENGTH 8
+#define AUTOCORRECT_MAX_CORRECTION_LENGTH 3
+#define AUTOCORRECT_BITMAP_TRIE
+#define AUTOCORRECT_TRIE_NODES 58179
+#define AUTOCORRECT_CORRECTIONS_SIZE 50000
@@ -0,0 +1,9 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+// The dictionary image is built by the test and served from a fake flash chip
+#define AUTOCORRECT_FLASH_OFFSET 0x1000
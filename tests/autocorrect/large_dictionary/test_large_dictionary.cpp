@@ -0,0 +1,233 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "test_common.hpp"
+#include "flash.h"
+#include "autocorrect_data.h"
+
+namespace {
+
+struct Entry {
+    std::string typo;
+    std::string correction;
+};
+
+uint32_t rng_state;
+
+uint32_t next_random(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+// 10000 random eight letter typos, corrected by swapping their sixth and seventh letters.
+std::vector<Entry> make_dictionary(void) {
+    std::vector<Entry>    dictionary;
+    std::set<std::string> seen;
+
+    rng_state = 0x2545F491;
+    while (dictionary.size() < 10000) {
+        std::string typo;
+        for (int i = 0; i < 8; ++i) {
+            typo += 'a' + next_random() % 26;
+        }
+        if (typo[5] == typo[6] || !seen.insert(typo).second) {
+            continue;
+        }
+        std::string correction = typo;
+        std::swap(correction[5], correction[6]);
+        dictionary.push_back({typo, correction});
+    }
+    return dictionary;
+}
+
+// Same layout as `qmk generate-autocorrect-data --format bitmap --binary`.
+std::vector<uint8_t> make_image(const std::vector<Entry> &dictionary, size_t *node_count, size_t *corrections_size) {
+    struct Node {
+        std::map<uint8_t, size_t> children;
+        const Entry              *entry = nullptr;
+    };
+    std::vector<Node> trie(1);
+
+    for (const Entry &e : dictionary) {
+        size_t node = 0;
+        for (auto c = e.typo.rbegin(); c != e.typo.rend(); ++c) {
+            uint8_t bit = *c - 'a';
+            auto    it  = trie[node].children.find(bit);
+            if (it == trie[node].children.end()) {
+                trie.push_back({});
+                it = trie[node].children.emplace(bit, trie.size() - 1).first;
+            }
+            node = it->second;
+        }
+        trie[node].entry = &e;
+    }
+
+    std::vector<uint32_t> words;
+    std::vector<uint8_t>  corrections;
+    std::vector<size_t>   queue = {0};
+    for (size_t i = 0; i < queue.size(); ++i) {
+        const Node &node = trie[queue[i]];
+        if (node.entry) {
+            const std::string &typo = node.entry->typo, &correction = node.entry->correction;
+            size_t             same = 0;
+            while (same < typo.size() && typo[same] == correction[same]) {
+                ++same;
+            }
+            words.push_back(1UL << 31);
+            words.push_back(corrections.size());
+            corrections.push_back(typo.size() - same - 1);
+            corrections.insert(corrections.end(), correction.begin() + same, correction.end());
+            corrections.push_back(0);
+        } else {
+            uint32_t bitmap = 0;
+            for (auto &child : node.children) {
+                bitmap |= 1UL << child.first;
+            }
+            words.push_back(bitmap);
+            words.push_back(queue.size());
+            for (auto &child : node.children) {
+                queue.push_back(child.second);
+            }
+        }
+    }
+
+    std::vector<uint8_t> image;
+    for (uint32_t w : words) {
+        for (int i = 0; i < 4; ++i) {
+            image.push_back(w >> (i * 8));
+        }
+    }
+    image.insert(image.end(), corrections.begin(), corrections.end());
+
+    *node_count       = words.size() / 2;
+    *corrections_size = corrections.size();
+    return image;
+}
+
+std::vector<uint8_t> flash_image;
+uint32_t             flash_reads;
+std::string          last_typo;
+std::string          last_correct;
+uint32_t             corrections_applied;
+
+} // namespace
+
+extern "C" {
+flash_status_t flash_read_range(uint32_t addr, void *buf, size_t len) {
+    flash_reads++;
+    if (addr < AUTOCORRECT_FLASH_OFFSET || addr - AUTOCORRECT_FLASH_OFFSET + len > flash_image.size()) {
+        return FLASH_STATUS_BAD_ADDRESS;
+    }
+    memcpy(buf, flash_image.data() + addr - AUTOCORRECT_FLASH_OFFSET, len);
+    return FLASH_STATUS_SUCCESS;
+}
+
+bool apply_autocorrect(uint8_t backspaces, const char *str, char *typo, char *correct) {
+    last_typo    = typo;
+    last_correct = correct;
+    corrections_applied++;
+    return false;
+}
+}
+
+class LargeDictionary : public TestFixture {
+   public:
+    void SetUp() override {
+        if (dictionary.empty()) {
+            dictionary  = make_dictionary();
+            flash_image = make_image(dictionary, &node_count, &corrections_size);
+        }
+        autocorrect_enable();
+        corrections_applied = 0;
+    }
+
+    void TypeKey(uint16_t keycode) {
+        keyrecord_t record   = {};
+        record.event.pressed = true;
+        process_autocorrect(keycode, &record);
+    }
+
+    void TypeWord(const std::string &word) {
+        for (char c : word) {
+            TypeKey(KC_A + c - 'a');
+        }
+    }
+
+    static std::vector<Entry> dictionary;
+    static size_t             node_count;
+    static size_t             corrections_size;
+};
+
+std::vector<Entry> LargeDictionary::dictionary;
+size_t             LargeDictionary::node_count;
+size_t             LargeDictionary::corrections_size;
+
+TEST_F(LargeDictionary, ImageMatchesHeader) {
+    EXPECT_EQ(node_count, AUTOCORRECT_TRIE_NODES);
+    EXPECT_EQ(corrections_size, AUTOCORRECT_CORRECTIONS_SIZE);
+}
+
+TEST_F(LargeDictionary, CorrectsEntriesFromFlash) {
+    for (size_t i = 0; i < dictionary.size(); i += 97) {
+        TypeKey(KC_SPC);
+        uint32_t applied = corrections_applied;
+        TypeWord(dictionary[i].typo);
+        ASSERT_EQ(corrections_applied, applied + 1) << dictionary[i].typo;
+        EXPECT_EQ(last_typo, dictionary[i].typo);
+        EXPECT_EQ(last_correct, dictionary[i].correction);
+    }
+}
+
+TEST_F(LargeDictionary, IgnoresWordsNotInDictionary) {
+    std::string word = dictionary[0].typo;
+    // Words differing from a typo only in their first letter share all of its trie path but the last node
+    for (char c = 'a'; c <= 'z'; ++c) {
+        word[0] = c;
+        bool known = false;
+        for (const Entry &e : dictionary) {
+            known |= e.typo == word;
+        }
+        if (known) {
+            continue;
+        }
+        TypeKey(KC_SPC);
+        TypeWord(word);
+    }
+    EXPECT_EQ(corrections_applied, 0);
+}
+
+TEST_F(LargeDictionary, ReadsOneNodePerLetter) {
+    uint32_t max_reads = 0;
+    rng_state          = 12345;
+    TypeKey(KC_SPC);
+    for (int i = 0; i < 100000; ++i) {
+        flash_reads = 0;
+        TypeKey(KC_A + next_random() % 26);
+        max_reads = std::max(max_reads, flash_reads);
+    }
+    // The root, then one node per buffered letter, however many siblings each has
+    EXPECT_LE(max_reads, AUTOCORRECT_MAX_LENGTH + 1);
+}
+
+TEST_F(LargeDictionary, Benchmark) {
+    const int keys = 1000000;
+    rng_state      = 54321;
+    TypeKey(KC_SPC);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < keys; ++i) {
+        TypeKey(KC_A + next_random() % 26);
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    printf("%zu entries, %zu nodes, %zu byte image: %.0f ns per key\n", dictionary.size(), node_count, flash_image.size(), elapsed * 1e9 / keys);
+}
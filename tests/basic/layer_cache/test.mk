@@ -0,0 +1,5 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+# Same behaviour as without the cache
+SRC += ../test_action_layer.cpp ../test_keypress.cpp ../test_one_shot_keys.cpp ../test_tapping.cpp
@@ -0,0 +1,102 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <cstdio>
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+class LayerCache : public TestFixture {};
+
+TEST_F(LayerCache, FollowsLayerStateChanges) {
+    TestDriver driver;
+    auto       key = keypos_t{.col = 0, .row = 0};
+
+    set_keymap({KeymapKey(0, 0, 0, KC_A), KeymapKey(1, 0, 0, KC_B), KeymapKey(2, 0, 0, KC_TRNS)});
+
+    EXPECT_EQ(layer_switch_get_layer(key), 0);
+    layer_on(1);
+    EXPECT_EQ(layer_switch_get_layer(key), 1);
+    layer_on(2);
+    EXPECT_EQ(layer_switch_get_layer(key), 1);
+    layer_off(1);
+    EXPECT_EQ(layer_switch_get_layer(key), 0);
+
+    /* Assigning the state directly, as split slaves do, is picked up as well. */
+    default_layer_state = 1 << 1;
+    EXPECT_EQ(layer_switch_get_layer(key), 1);
+    default_layer_state = 1 << 0;
+    EXPECT_EQ(layer_switch_get_layer(key), 0);
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LayerCache, FollowsKeymapChanges) {
+    TestDriver driver;
+    InSequence s;
+    auto       key = keypos_t{.col = 0, .row = 0};
+
+    set_keymap({KeymapKey(0, 0, 0, KC_A), KeymapKey(1, 0, 0, KC_B)});
+    layer_on(1);
+    EXPECT_EQ(layer_switch_get_layer(key), 1);
+
+    set_keymap({KeymapKey(0, 0, 0, KC_A), KeymapKey(1, 0, 0, KC_TRNS)});
+    EXPECT_EQ(layer_switch_get_layer(key), 0);
+
+    auto regular_key = KeymapKey(0, 0, 0, KC_A);
+    EXPECT_REPORT(driver, (KC_A));
+    regular_key.press();
+    run_one_scan_loop();
+    EXPECT_EMPTY_REPORT(driver);
+    regular_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+/* Measures how fast a key resolves through a stack of transparent layers,
+ * with the cache emptied before every lookup and with a warm cache. */
+TEST_F(LayerCache, Benchmark) {
+    TestDriver driver;
+    const int  lookups = 10000;
+
+    for (uint8_t layer_count = 1; layer_count <= MAX_LAYER; layer_count *= 2) {
+        set_keymap({});
+        layer_state_t layers = 0;
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                add_key(KeymapKey(0, col, row, KC_A));
+                for (uint8_t layer = 1; layer < layer_count; layer++) {
+                    add_key(KeymapKey(layer, col, row, KC_TRNS));
+                }
+            }
+        }
+        for (uint8_t layer = 1; layer < layer_count; layer++) {
+            layers |= (layer_state_t)1 << layer;
+        }
+        layer_state_set(layers);
+
+        auto     start    = std::chrono::steady_clock::now();
+        unsigned resolved = 0;
+        for (int i = 0; i < lookups; i++) {
+            layer_cache_invalidate();
+            resolved += layer_switch_get_layer({.col = (uint8_t)(i % MATRIX_COLS), .row = (uint8_t)(i % MATRIX_ROWS)});
+        }
+        double cold = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < lookups; i++) {
+            resolved += layer_switch_get_layer({.col = (uint8_t)(i % MATRIX_COLS), .row = (uint8_t)(i % MATRIX_ROWS)});
+        }
+        double warm = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        EXPECT_EQ(resolved, 0);
+        printf("%2u layers: %12.0f lookups/s uncached, %12.0f lookups/s cached\n", layer_count, lookups / cold, lookups / warm);
+    }
+
+    layer_clear();
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,9 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+COMBO_ENABLE = yes
+
+INTROSPECTION_KEYMAP_C = ../test_combos.c
+
+# Same behaviour as without the index
+SRC += ../test_combo.cpp
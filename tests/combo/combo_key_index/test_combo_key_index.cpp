@@ -0,0 +1,141 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <cstdio>
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+extern "C" {
+#include "keymap_introspection.h"
+}
+
+using testing::_;
+using testing::AnyNumber;
+using testing::InSequence;
+
+/* 325 two key combos, one for every pair of letters, plus one three key combo. */
+#define LETTERS 26
+#define PAIRS (LETTERS * (LETTERS - 1) / 2)
+
+static uint16_t many_combo_keys[PAIRS + 1][4];
+static combo_t  many_combos[PAIRS + 1];
+static bool     use_many_combos = false;
+static unsigned combo_lookups   = 0;
+
+extern "C" {
+uint16_t combo_count(void) {
+    return use_many_combos ? PAIRS + 1 : combo_count_raw();
+}
+
+combo_t *combo_get(uint16_t combo_idx) {
+    combo_lookups++;
+    return use_many_combos ? &many_combos[combo_idx] : combo_get_raw(combo_idx);
+}
+}
+
+class ComboKeyIndex : public TestFixture {
+   protected:
+    void SetUp() override {
+        uint16_t index = 0;
+        for (uint16_t first = 0; first < LETTERS; first++) {
+            for (uint16_t second = first + 1; second < LETTERS; second++) {
+                many_combo_keys[index][0] = KC_A + first;
+                many_combo_keys[index][1] = KC_A + second;
+                many_combo_keys[index][2] = COMBO_END;
+                many_combos[index]        = (combo_t)COMBO_ACTION(many_combo_keys[index]);
+                if (first == 0 && second == 1) {
+                    many_combos[index].keycode = KC_ESC;
+                }
+                index++;
+            }
+        }
+        many_combo_keys[index][0] = KC_A;
+        many_combo_keys[index][1] = KC_B;
+        many_combo_keys[index][2] = KC_C;
+        many_combo_keys[index][3] = COMBO_END;
+        many_combos[index]        = (combo_t)COMBO(many_combo_keys[index], KC_TAB);
+
+        use_many_combos = true;
+        combo_key_index_rebuild();
+    }
+
+    void TearDown() override {
+        use_many_combos = false;
+        combo_key_index_rebuild();
+    }
+};
+
+TEST_F(ComboKeyIndex, TriggersCombosFromTheIndex) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 0, 0, KC_A);
+    KeymapKey  key_b(0, 1, 0, KC_B);
+    KeymapKey  key_c(0, 2, 0, KC_C);
+    set_keymap({key_a, key_b, key_c});
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_ESC));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_a, key_b});
+    VERIFY_AND_CLEAR(driver);
+
+    /* The longer of two overlapping combos wins. */
+    EXPECT_REPORT(driver, (KC_TAB));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_a, key_b, key_c});
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_a);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ComboKeyIndex, OnlyVisitsCombosOfTheKey) {
+    TestDriver driver;
+    KeymapKey  key_z(0, 0, 0, KC_Z);
+    KeymapKey  key_1(0, 1, 0, KC_1);
+    set_keymap({key_z, key_1});
+
+    /* Build the index outside of the measurement. */
+    EXPECT_REPORT(driver, (KC_1));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_1);
+    VERIFY_AND_CLEAR(driver);
+
+    combo_lookups = 0;
+    EXPECT_REPORT(driver, (KC_1));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_1);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(combo_lookups, 0u);
+
+    /* KC_Z is part of 25 combos, scanning all of them would take 326 lookups per event. */
+    combo_lookups = 0;
+    EXPECT_REPORT(driver, (KC_Z));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_z);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_LE(combo_lookups, 4u * (LETTERS - 1));
+}
+
+TEST_F(ComboKeyIndex, Benchmark) {
+    TestDriver driver;
+    KeymapKey  key_z(0, 0, 0, KC_Z);
+    KeymapKey  key_1(0, 1, 0, KC_1);
+    set_keymap({key_z, key_1});
+    const int taps = 2000;
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    for (KeymapKey *key : {&key_1, &key_z}) {
+        tap_key(*key);
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < taps; i++) {
+            tap_key(*key);
+        }
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        printf("%u combos, key in %2u of them: %10.0f taps/s\n", PAIRS + 1, key == &key_z ? LETTERS - 1 : 0, taps / elapsed);
+    }
+    VERIFY_AND_CLEAR(driver);
+}
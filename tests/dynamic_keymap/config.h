@@ -0,0 +1,11 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define EEPROM_SIZE 1024
+#define DYNAMIC_KEYMAP_RAM_SHADOW
+#define DYNAMIC_KEYMAP_FLUSH_DELAY 100
+#define DYNAMIC_KEYMAP_FLUSH_BATCH 4
@@ -0,0 +1,126 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keycode.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "dynamic_keymap.h"
+#include "eeprom.h"
+}
+
+#define KEY_COUNT (DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS)
+
+/* Reads a keycode straight from the test EEPROM, bypassing the shadow. */
+static uint16_t eeprom_keycode(uint8_t layer, uint8_t row, uint8_t column) {
+    const uint8_t *address = (const uint8_t *)dynamic_keymap_key_to_eeprom_address(layer, row, column);
+    return (eeprom_read_byte(address) << 8) | eeprom_read_byte(address + 1);
+}
+
+class DynamicKeymapShadow : public TestFixture {
+   protected:
+    void SetUp() override {
+        dynamic_keymap_reset();
+    }
+
+    /* Checks every key of the shadow against the EEPROM. */
+    void expect_persisted() {
+        for (uint8_t layer = 0; layer < DYNAMIC_KEYMAP_LAYER_COUNT; layer++) {
+            for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+                for (uint8_t column = 0; column < MATRIX_COLS; column++) {
+                    EXPECT_EQ(dynamic_keymap_get_keycode(layer, row, column), eeprom_keycode(layer, row, column)) << "layer " << +layer << " row " << +row << " column " << +column;
+                }
+            }
+        }
+    }
+};
+
+TEST_F(DynamicKeymapShadow, ResetPersistsImmediately) {
+    TestDriver driver;
+
+    dynamic_keymap_set_keycode(0, 2, 3, KC_B);
+    dynamic_keymap_set_keycode(1, 2, 3, KC_B);
+    dynamic_keymap_reset();
+
+    /* The test keymap only defines layer 0, the others reset to transparent. */
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 2, 3), KC_NO);
+    EXPECT_EQ(dynamic_keymap_get_keycode(1, 2, 3), KC_TRNS);
+    expect_persisted();
+}
+
+TEST_F(DynamicKeymapShadow, WritesBackOnceIdle) {
+    TestDriver driver;
+
+    dynamic_keymap_set_keycode(0, 1, 2, KC_A);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 1, 2), KC_A);
+    EXPECT_EQ(eeprom_keycode(0, 1, 2), KC_NO);
+
+    /* Each further change restarts the delay. */
+    idle_for(DYNAMIC_KEYMAP_FLUSH_DELAY - 10);
+    dynamic_keymap_set_keycode(3, 3, 9, LT(1, KC_Z));
+    idle_for(DYNAMIC_KEYMAP_FLUSH_DELAY - 10);
+    EXPECT_EQ(eeprom_keycode(0, 1, 2), KC_NO);
+    EXPECT_EQ(eeprom_keycode(3, 3, 9), KC_TRNS);
+
+    idle_for(20);
+    EXPECT_EQ(eeprom_keycode(0, 1, 2), KC_A);
+    EXPECT_EQ(eeprom_keycode(3, 3, 9), LT(1, KC_Z));
+    expect_persisted();
+}
+
+TEST_F(DynamicKeymapShadow, BulkUploadIsFlushedInBatches) {
+    TestDriver driver;
+    uint8_t    keymap[KEY_COUNT * 2];
+
+    for (uint16_t i = 0; i < KEY_COUNT; i++) {
+        keymap[i * 2]     = (uint8_t)((KC_A + i) >> 8);
+        keymap[i * 2 + 1] = (uint8_t)(KC_A + i);
+    }
+
+    /* Upload in odd sized chunks, splitting keycodes across calls. */
+    for (uint16_t offset = 0; offset < sizeof(keymap); offset += 27) {
+        uint16_t size = sizeof(keymap) - offset < 27 ? sizeof(keymap) - offset : 27;
+        dynamic_keymap_set_buffer(offset, size, &keymap[offset]);
+    }
+
+    uint8_t readback[sizeof(keymap)];
+    dynamic_keymap_get_buffer(0, sizeof(readback), readback);
+    EXPECT_EQ(memcmp(keymap, readback, sizeof(keymap)), 0);
+    EXPECT_EQ(dynamic_keymap_get_keycode(1, 0, 0), KC_A + MATRIX_ROWS * MATRIX_COLS);
+    EXPECT_EQ(eeprom_keycode(1, 0, 0), KC_TRNS);
+
+    /* Once idle, a bounded number of keys is written per scan. */
+    idle_for(DYNAMIC_KEYMAP_FLUSH_DELAY);
+    run_one_scan_loop();
+    EXPECT_EQ(eeprom_keycode(0, 0, 0), KC_A);
+    EXPECT_EQ(eeprom_keycode(0, 0, DYNAMIC_KEYMAP_FLUSH_BATCH), KC_NO);
+
+    idle_for(KEY_COUNT / DYNAMIC_KEYMAP_FLUSH_BATCH);
+    expect_persisted();
+}
+
+TEST_F(DynamicKeymapShadow, FlushWritesEverything) {
+    TestDriver driver;
+
+    dynamic_keymap_set_keycode(2, 0, 0, KC_C);
+    dynamic_keymap_set_keycode(2, 3, 9, KC_D);
+    dynamic_keymap_flush();
+
+    EXPECT_EQ(eeprom_keycode(2, 0, 0), KC_C);
+    EXPECT_EQ(eeprom_keycode(2, 3, 9), KC_D);
+    expect_persisted();
+}
+
+TEST_F(DynamicKeymapShadow, IgnoresOutOfRangeKeys) {
+    TestDriver driver;
+
+    dynamic_keymap_set_keycode(DYNAMIC_KEYMAP_LAYER_COUNT, 0, 0, KC_A);
+    dynamic_keymap_set_keycode(0, MATRIX_ROWS, 0, KC_A);
+    dynamic_keymap_set_keycode(0, 0, MATRIX_COLS, KC_A);
+
+    EXPECT_EQ(dynamic_keymap_get_keycode(DYNAMIC_KEYMAP_LAYER_COUNT, 0, 0), KC_NO);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, MATRIX_ROWS, 0), KC_NO);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 0, MATRIX_COLS), KC_NO);
+    idle_for(DYNAMIC_KEYMAP_FLUSH_DELAY * 2);
+    expect_persisted();
+}
@@ -0,0 +1,5 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+HOST_REPORT_QUEUE_ENABLE = yes
+SEND_STRING_ENABLE = yes
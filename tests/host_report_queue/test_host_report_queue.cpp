@@ -0,0 +1,194 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstdio>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+class HostReportQueue : public TestFixture {};
+
+TEST_F(HostReportQueue, KeysFromTheMatrixAreSentRightAway) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 0, 0, KC_A);
+    set_keymap({key_a});
+
+    EXPECT_REPORT(driver, (KC_A));
+    key_a.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(host_report_queue_pending(), 0);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(HostReportQueue, SendsOneReportPerInterval) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_A));
+    SEND_STRING("aa");
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(host_report_queue_pending(), 3);
+
+    EXPECT_NO_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // Releasing and pressing the same key again cannot be folded
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(HOST_REPORT_QUEUE_INTERVAL);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A));
+    idle_for(HOST_REPORT_QUEUE_INTERVAL);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(HOST_REPORT_QUEUE_INTERVAL);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(host_report_queue_pending(), 0);
+}
+
+TEST_F(HostReportQueue, ReleaseIsFoldedIntoTheNextPress) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_REPORT(driver, (KC_C));
+    EXPECT_EMPTY_REPORT(driver);
+    SEND_STRING("abc");
+    EXPECT_EQ(host_report_queue_pending(), 3);
+    idle_for(4 * HOST_REPORT_QUEUE_INTERVAL);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(HostReportQueue, ModifierIsFoldedIntoTheKeyItModifies) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    SEND_STRING("aB");
+    idle_for(3 * HOST_REPORT_QUEUE_INTERVAL);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(HostReportQueue, EveryPressGetsItsOwnReport) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_REPORT(driver, (KC_A, KC_B));
+    EXPECT_REPORT(driver, (KC_A, KC_B, KC_C));
+    register_code(KC_A);
+    register_code(KC_B);
+    register_code(KC_C);
+    idle_for(3 * HOST_REPORT_QUEUE_INTERVAL);
+    VERIFY_AND_CLEAR(driver);
+
+    // Modifiers changed after a press would apply to it as well
+    EXPECT_REPORT(driver, (KC_A, KC_B, KC_C, KC_D));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_A, KC_B, KC_C, KC_D));
+    register_code(KC_D);
+    register_code(KC_LEFT_SHIFT);
+    idle_for(2 * HOST_REPORT_QUEUE_INTERVAL);
+    VERIFY_AND_CLEAR(driver);
+
+    // Releases that follow each other are folded together
+    EXPECT_EMPTY_REPORT(driver);
+    clear_keyboard();
+    idle_for(HOST_REPORT_QUEUE_INTERVAL);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(HostReportQueue, FullQueueHandsOverTheOldestReport) {
+    TestDriver driver;
+    InSequence s;
+
+    for (int i = 0; i < 4; i++) {
+        EXPECT_REPORT(driver, (KC_A));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    SEND_STRING("aaaa");
+    EXPECT_EQ(host_report_queue_pending(), HOST_REPORT_QUEUE_SIZE - 1);
+    idle_for(HOST_REPORT_QUEUE_SIZE * HOST_REPORT_QUEUE_INTERVAL);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(HostReportQueue, FullQueueLeavesTheDriverItsReports) {
+    TestDriver driver;
+
+    // A full queue hands its oldest report over early, while the driver may
+    // still be sending the one before, so that one must stay untouched
+    std::vector<std::pair<const report_keyboard_t *, report_keyboard_t>> sent;
+    EXPECT_ANY_REPORT(driver).WillRepeatedly([&sent](report_keyboard_t &report) {
+        if (sent.size() >= 2) {
+            EXPECT_EQ(memcmp(sent[sent.size() - 2].first, &sent[sent.size() - 2].second, sizeof(report_keyboard_t)), 0);
+        }
+        sent.emplace_back(&report, report);
+    });
+    SEND_STRING("abcdefgh");
+    idle_for(HOST_REPORT_QUEUE_SIZE * HOST_REPORT_QUEUE_INTERVAL);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(HostReportQueue, FlushSendsEverythingAtOnce) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    SEND_STRING("ab");
+    host_report_queue_flush();
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(host_report_queue_pending(), 0);
+}
+
+TEST_F(HostReportQueue, TextNeedsFewerReports) {
+    TestDriver  driver;
+    const char *text    = "the quick brown fox jumps over the lazy dog";
+    unsigned    reports = 0;
+
+    EXPECT_ANY_REPORT(driver).WillRepeatedly([&reports](report_keyboard_t &) { reports++; });
+    send_string(text);
+    idle_for(strlen(text) * 2 * HOST_REPORT_QUEUE_INTERVAL);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_LT(reports, strlen(text) * 2);
+    printf("%zu characters: %u reports instead of %zu\n", strlen(text), reports, strlen(text) * 2);
+}
+
+TEST_F(HostReportQueue, OtherReportsWaitForQueuedKeys) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_CALL(driver, send_mouse_mock(_));
+    SEND_STRING("ab");
+    report_mouse_t mouse_report = {};
+    host_mouse_send(&mouse_report);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(host_report_queue_pending(), 0);
+
+    EXPECT_REPORT(driver, (KC_C));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_CALL(driver, send_extra_mock(_));
+    SEND_STRING("c");
+    host_consumer_send(AUDIO_MUTE);
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,43 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "key_event_queue.h"
+}
+
+using testing::_;
+using testing::InSequence;
+
+class KeyEventQueueAsyncScan : public TestFixture {};
+
+TEST_F(KeyEventQueueAsyncScan, MainLoopOnlyProcessesWhatWasScanned) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key_a});
+
+    // Nothing scans the matrix from the main loop
+    EXPECT_NO_REPORT(driver);
+    key_a.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    EXPECT_TRUE(keyboard_scan_task());
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    keyboard_scan_task();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
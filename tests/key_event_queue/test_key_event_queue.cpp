@@ -0,0 +1,136 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <thread>
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "key_event_queue.h"
+}
+
+using testing::_;
+using testing::InSequence;
+
+class KeyEventQueue : public TestFixture {};
+
+TEST_F(KeyEventQueue, ProcessesQueuedKeys) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_b = KeymapKey(0, 1, 1, KC_B);
+
+    set_keymap({key_a, key_b});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_REPORT(driver, (KC_A, KC_B));
+    key_a.press();
+    key_b.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    key_b.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(key_event_queue_count(), 0);
+}
+
+TEST_F(KeyEventQueue, RetriesChangesThatOverflow) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_a     = KeymapKey(0, 0, 0, KC_A);
+    auto       key_b     = KeymapKey(0, 1, 0, KC_B);
+    auto       key_c     = KeymapKey(0, 2, 0, KC_C);
+    auto       key_d     = KeymapKey(0, 3, 0, KC_D);
+    auto       key_e     = KeymapKey(0, 4, 0, KC_E);
+    auto       key_f     = KeymapKey(0, 0, 1, KC_F);
+    uint16_t   overflows = key_event_queue_overflows();
+
+    set_keymap({key_a, key_b, key_c, key_d, key_e, key_f});
+
+    /* Six keys change in the same scan, only four fit into the queue. */
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_REPORT(driver, (KC_A, KC_B));
+    EXPECT_REPORT(driver, (KC_A, KC_B, KC_C));
+    EXPECT_REPORT(driver, (KC_A, KC_B, KC_C, KC_D));
+    for (auto key : {key_a, key_b, key_c, key_d, key_e, key_f}) {
+        key.press();
+    }
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(key_event_queue_overflows() - overflows, 1);
+    EXPECT_EQ(key_event_queue_high_water(), KEY_EVENT_QUEUE_SIZE);
+
+    /* The rest is picked up by the next scan. */
+    EXPECT_REPORT(driver, (KC_A, KC_B, KC_C, KC_D, KC_E));
+    EXPECT_REPORT(driver, (KC_A, KC_B, KC_C, KC_D, KC_E, KC_F));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B, KC_C, KC_D, KC_E, KC_F));
+    EXPECT_REPORT(driver, (KC_C, KC_D, KC_E, KC_F));
+    EXPECT_REPORT(driver, (KC_D, KC_E, KC_F));
+    EXPECT_REPORT(driver, (KC_E, KC_F));
+    EXPECT_REPORT(driver, (KC_F));
+    EXPECT_EMPTY_REPORT(driver);
+    for (auto key : {key_a, key_b, key_c, key_d, key_e, key_f}) {
+        key.release();
+    }
+    run_one_scan_loop();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+/* Hammers the queue from a producer and a consumer thread, checking that
+ * every event arrives exactly once, in order, and that every failed push was
+ * accounted as an overflow. */
+TEST_F(KeyEventQueue, StressTwoThreads) {
+    TestDriver     driver;
+    const uint32_t events    = 200000;
+    uint16_t       overflows = key_event_queue_overflows();
+    uint32_t       rejected  = 0;
+
+    std::thread producer([&]() {
+        for (uint32_t i = 0; i < events;) {
+            keyevent_t event = {};
+            event.key.col    = (uint8_t)(i >> 8);
+            event.key.row    = (uint8_t)(i >> 16);
+            event.time       = (uint16_t)i;
+            event.type       = KEY_EVENT;
+            event.pressed    = i & 1;
+            if (key_event_queue_push(event)) {
+                i++;
+            } else {
+                rejected++;
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    uint32_t   received = 0;
+    bool       in_order = true;
+    keyevent_t event;
+    while (received < events) {
+        if (!key_event_queue_pop(&event)) {
+            std::this_thread::yield();
+            continue;
+        }
+        uint32_t sequence = ((uint32_t)event.key.row << 16) | ((uint32_t)event.key.col << 8) | (event.time & 0xFF);
+        if (sequence != received || event.time != (uint16_t)received || event.pressed != (received & 1)) {
+            in_order = false;
+        }
+        received++;
+    }
+    producer.join();
+
+    EXPECT_TRUE(in_order);
+    EXPECT_FALSE(key_event_queue_pop(&event));
+    EXPECT_EQ(key_event_queue_count(), 0);
+    EXPECT_EQ((uint16_t)(key_event_queue_overflows() - overflows), (uint16_t)rejected);
+}
@@ -0,0 +1,9 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+KEY_OVERRIDE_ENABLE = yes
+
+INTROSPECTION_KEYMAP_C = ../test_key_overrides.c
+
+# Same behaviour as without the index
+SRC += ../test_key_override.cpp ../test_key_override_many.cpp
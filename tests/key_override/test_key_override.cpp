@@ -0,0 +1,177 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+class KeyOverride : public TestFixture {};
+
+TEST_F(KeyOverride, ReplacesTriggerWhileModifierIsHeld) {
+    TestDriver driver;
+    KeymapKey  key_shift(0, 0, 0, KC_LSFT);
+    KeymapKey  key_bspc(0, 1, 0, KC_BSPC);
+    set_keymap({key_shift, key_bspc});
+
+    InSequence s;
+    EXPECT_REPORT(driver, (KC_LSFT));
+    key_shift.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // The trigger mods are suppressed while the replacement is held
+    EXPECT_REPORT(driver, (KC_DEL));
+    key_bspc.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LSFT));
+    key_bspc.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_shift.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyOverride, ActivatesOnModifierAfterRepeatDelay) {
+    TestDriver driver;
+    KeymapKey  key_shift(0, 0, 0, KC_LSFT);
+    KeymapKey  key_bspc(0, 1, 0, KC_BSPC);
+    set_keymap({key_shift, key_bspc});
+
+    InSequence s;
+    EXPECT_REPORT(driver, (KC_BSPC));
+    key_bspc.press();
+    idle_for(100);
+    VERIFY_AND_CLEAR(driver);
+
+    // The trigger is released right away, the replacement follows once the key would start repeating
+    EXPECT_EMPTY_REPORT(driver);
+    key_shift.press();
+    idle_for(300);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_DEL));
+    idle_for(200);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_EMPTY_REPORT(driver);
+    key_bspc.release();
+    run_one_scan_loop();
+    key_shift.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyOverride, FirstMatchingOverrideWins) {
+    TestDriver driver;
+    KeymapKey  key_shift(0, 0, 0, KC_LSFT);
+    KeymapKey  key_b(0, 1, 0, KC_B);
+    set_keymap({key_shift, key_b});
+
+    InSequence s;
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_REPORT(driver, (KC_X));
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_EMPTY_REPORT(driver);
+    key_shift.press();
+    run_one_scan_loop();
+    tap_key(key_b);
+    key_shift.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyOverride, SameTriggerWithDifferentModifiers) {
+    TestDriver driver;
+    KeymapKey  key_ctrl(0, 0, 0, KC_LCTL);
+    KeymapKey  key_alt(0, 1, 0, KC_LALT);
+    KeymapKey  key_a(0, 2, 0, KC_A);
+    set_keymap({key_ctrl, key_alt, key_a});
+
+    InSequence s;
+    EXPECT_REPORT(driver, (KC_LCTL));
+    EXPECT_REPORT(driver, (KC_HOME));
+    EXPECT_REPORT(driver, (KC_LCTL));
+    EXPECT_EMPTY_REPORT(driver);
+    key_ctrl.press();
+    run_one_scan_loop();
+    tap_key(key_a);
+    key_ctrl.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LALT));
+    EXPECT_REPORT(driver, (KC_END));
+    EXPECT_REPORT(driver, (KC_LALT));
+    EXPECT_EMPTY_REPORT(driver);
+    key_alt.press();
+    run_one_scan_loop();
+    tap_key(key_a);
+    key_alt.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyOverride, OnlyActivatesOnItsLayers) {
+    TestDriver driver;
+    KeymapKey  key_shift(0, 0, 0, KC_LSFT);
+    KeymapKey  key_1(0, 1, 0, KC_1);
+    KeymapKey  key_1_layer_1(1, 1, 0, KC_1);
+    set_keymap({key_shift, key_1, key_1_layer_1});
+
+    InSequence s;
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_REPORT(driver, (KC_1, KC_LSFT));
+    EXPECT_REPORT(driver, (KC_LSFT));
+    key_shift.press();
+    run_one_scan_loop();
+    tap_key(key_1);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_2));
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_EMPTY_REPORT(driver);
+    layer_on(1);
+    tap_key(key_1_layer_1);
+    layer_off(1);
+    key_shift.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyOverride, ActivatesOnModifiersAlone) {
+    TestDriver driver;
+    KeymapKey  key_ctrl(0, 0, 0, KC_LCTL);
+    KeymapKey  key_gui(0, 1, 0, KC_LGUI);
+    set_keymap({key_ctrl, key_gui});
+
+    InSequence s;
+    EXPECT_REPORT(driver, (KC_LCTL));
+    EXPECT_EMPTY_REPORT(driver);
+    key_ctrl.press();
+    run_one_scan_loop();
+    key_gui.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_F12));
+    idle_for(500);
+    VERIFY_AND_CLEAR(driver);
+
+    // Releasing a required modifier unsuppresses the mods before it is removed
+    EXPECT_REPORT(driver, (KC_LCTL, KC_LGUI));
+    EXPECT_REPORT(driver, (KC_LCTL));
+    EXPECT_EMPTY_REPORT(driver);
+    key_gui.release();
+    run_one_scan_loop();
+    key_ctrl.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
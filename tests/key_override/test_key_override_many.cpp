@@ -0,0 +1,146 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <cstdio>
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+extern "C" {
+#include "keymap_introspection.h"
+}
+
+using testing::_;
+using testing::InSequence;
+
+/* 312 overrides, one for each letter and each of twelve modifier masks, replacing the letter with F1 to F12. */
+#define LETTERS 26
+#define MOD_MASKS 12
+#define MANY_OVERRIDES (LETTERS * MOD_MASKS)
+
+static const uint8_t  many_override_mods[MOD_MASKS] = {MOD_BIT(KC_LCTL), MOD_BIT(KC_LSFT), MOD_BIT(KC_LALT), MOD_BIT(KC_LGUI), MOD_BIT(KC_RCTL), MOD_BIT(KC_RSFT), MOD_BIT(KC_RALT), MOD_BIT(KC_RGUI), MOD_MASK_CS, MOD_MASK_CA, MOD_MASK_CG, MOD_MASK_SA};
+static key_override_t many_overrides[MANY_OVERRIDES];
+static bool           use_many_overrides = false;
+static unsigned       override_lookups   = 0;
+
+extern "C" {
+uint16_t key_override_count(void) {
+    return use_many_overrides ? MANY_OVERRIDES : key_override_count_raw();
+}
+
+const key_override_t *key_override_get(uint16_t key_override_idx) {
+    override_lookups++;
+    if (!use_many_overrides) {
+        return key_override_get_raw(key_override_idx);
+    }
+    return key_override_idx < MANY_OVERRIDES ? &many_overrides[key_override_idx] : NULL;
+}
+}
+
+class ManyKeyOverrides : public TestFixture {
+   protected:
+    void SetUp() override {
+        for (uint16_t letter = 0; letter < LETTERS; letter++) {
+            for (uint8_t mods = 0; mods < MOD_MASKS; mods++) {
+                // Same as ko_make_basic(), which C++ cannot compile
+                key_override_t *override    = &many_overrides[letter * MOD_MASKS + mods];
+                *override                   = {};
+                override->trigger           = KC_A + letter;
+                override->trigger_mods      = many_override_mods[mods];
+                override->layers            = ~0;
+                override->suppressed_mods   = many_override_mods[mods];
+                override->replacement       = KC_F1 + mods;
+                override->options           = ko_options_default;
+            }
+        }
+        use_many_overrides = true;
+        key_override_index_rebuild();
+    }
+
+    void TearDown() override {
+        use_many_overrides = false;
+        key_override_index_rebuild();
+    }
+};
+
+TEST_F(ManyKeyOverrides, TriggersTheFirstMatchingOverride) {
+    TestDriver driver;
+    KeymapKey  key_shift(0, 0, 0, KC_LSFT);
+    KeymapKey  key_rgui(0, 1, 0, KC_RGUI);
+    KeymapKey  key_c(0, 2, 0, KC_C);
+    KeymapKey  key_z(0, 3, 0, KC_Z);
+    set_keymap({key_shift, key_rgui, key_c, key_z});
+
+    InSequence s;
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_REPORT(driver, (KC_F2));
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_EMPTY_REPORT(driver);
+    key_shift.press();
+    run_one_scan_loop();
+    tap_key(key_c);
+    key_shift.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_RGUI));
+    EXPECT_REPORT(driver, (KC_F8));
+    EXPECT_REPORT(driver, (KC_RGUI));
+    EXPECT_EMPTY_REPORT(driver);
+    key_rgui.press();
+    run_one_scan_loop();
+    tap_key(key_z);
+    key_rgui.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ManyKeyOverrides, OnlyVisitsOverridesOfTheKey) {
+    TestDriver driver;
+    KeymapKey  key_shift(0, 0, 0, KC_LSFT);
+    KeymapKey  key_1(0, 1, 0, KC_1);
+    set_keymap({key_shift, key_1});
+
+    EXPECT_REPORT(driver, (KC_LSFT));
+    key_shift.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // No override is triggered by KC_1
+    override_lookups = 0;
+    EXPECT_REPORT(driver, (KC_1, KC_LSFT));
+    key_1.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+#ifdef KEY_OVERRIDE_INDEX
+    EXPECT_EQ(override_lookups, 0);
+#else
+    EXPECT_EQ(override_lookups, MANY_OVERRIDES);
+#endif
+
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_EMPTY_REPORT(driver);
+    key_1.release();
+    run_one_scan_loop();
+    key_shift.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ManyKeyOverrides, Benchmark) {
+    const int   events = 200000;
+    keyrecord_t record = {};
+
+    add_mods(MOD_BIT(KC_LSFT));
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < events; i++) {
+        // Digits, so no override activates and every event is checked against all candidates
+        record.event.pressed = !(i & 1);
+        process_key_override(KC_1 + (i / 2) % 10, &record);
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    del_mods(MOD_BIT(KC_LSFT));
+
+    printf("%u overrides: %.0f ns per key event\n", MANY_OVERRIDES, elapsed * 1e9 / events);
+}
@@ -0,0 +1,23 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "quantum.h"
+
+// clang-format off
+const key_override_t delete_override      = ko_make_basic(MOD_MASK_SHIFT, KC_BSPC, KC_DEL);
+const key_override_t home_override        = ko_make_basic(MOD_MASK_CTRL, KC_A, KC_HOME);
+const key_override_t end_override         = ko_make_basic(MOD_MASK_ALT, KC_A, KC_END);
+const key_override_t first_b_override     = ko_make_basic(MOD_MASK_SHIFT, KC_B, KC_X);
+const key_override_t second_b_override    = ko_make_basic(MOD_MASK_SHIFT, KC_B, KC_Y);
+const key_override_t layer_one_override   = ko_make_with_layers(MOD_MASK_SHIFT, KC_1, KC_2, 1 << 1);
+const key_override_t ctrl_gui_override    = ko_make_basic(MOD_MASK_CG, KC_NO, KC_F12);
+
+const key_override_t *key_overrides[] = {
+    &delete_override,
+    &home_override,
+    &end_override,
+    &first_b_override,
+    &second_b_override,
+    &layer_one_override,
+    &ctrl_gui_override,
+};
+// clang-format on
@@ -0,0 +1,20 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+
+const uint16_t PROGMEM leader_gs[]   = {KC_G, KC_S, LEADER_SEQUENCE_END};
+const uint16_t PROGMEM leader_gd[]   = {KC_G, KC_D, LEADER_SEQUENCE_END};
+const uint16_t PROGMEM leader_gdd[]  = {KC_G, KC_D, KC_D, LEADER_SEQUENCE_END};
+const uint16_t PROGMEM leader_long[] = {KC_L, KC_O, KC_N, KC_G, KC_E, KC_S, KC_T, KC_K, KC_E, KC_Y, LEADER_SEQUENCE_END};
+const uint16_t PROGMEM leader_x[]    = {KC_X, LEADER_SEQUENCE_END};
+
+const leader_sequence_t PROGMEM leader_sequences[] = {
+    LEADER_SEQUENCE(leader_gs, KC_F1),
+    LEADER_SEQUENCE(leader_gd, KC_F2),
+    LEADER_SEQUENCE(leader_gdd, KC_F3),
+    LEADER_SEQUENCE(leader_long, KC_F4),
+    // Shadowed by the first sequence
+    LEADER_SEQUENCE(leader_gs, KC_F5),
+    LEADER_SEQUENCE_ACTION(leader_x),
+};
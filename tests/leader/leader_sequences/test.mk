@@ -0,0 +1,10 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+LEADER_ENABLE = yes
+LEADER_SEQUENCES_ENABLE = yes
+
+INTROSPECTION_KEYMAP_C = leader_sequence_table.c
+
+# Sequences missing from the table still reach leader_end_user()
+SRC += ../leader_sequences.c
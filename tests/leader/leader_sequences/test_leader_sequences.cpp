@@ -0,0 +1,269 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_keymap_key.hpp"
+
+extern "C" {
+#include "keymap_introspection.h"
+#include "process_leader.h"
+}
+
+using testing::_;
+using testing::InSequence;
+
+/* 400 random sequences of 3 to 8 letters, none of them the start of another. */
+#define MANY_SEQUENCES 400
+
+static std::vector<std::vector<uint16_t>> many_sequences;
+static bool                               use_many_sequences = false;
+static unsigned                           key_lookups        = 0;
+static uint16_t                           last_event         = UINT16_MAX;
+
+extern "C" {
+uint16_t leader_sequences_count(void) {
+    return use_many_sequences ? MANY_SEQUENCES : leader_sequences_count_raw();
+}
+
+uint16_t leader_sequences_get_key(uint16_t sequence_idx, uint16_t key_idx) {
+    key_lookups++;
+    if (!use_many_sequences) {
+        return leader_sequences_get_key_raw(sequence_idx, key_idx);
+    }
+    return key_idx < many_sequences[sequence_idx].size() ? many_sequences[sequence_idx][key_idx] : LEADER_SEQUENCE_END;
+}
+
+uint16_t leader_sequences_get_keycode(uint16_t sequence_idx) {
+    return use_many_sequences ? KC_NO : leader_sequences_get_keycode_raw(sequence_idx);
+}
+
+void process_leader_sequence_event(uint16_t sequence_index) {
+    last_event = sequence_index;
+}
+}
+
+class LeaderSequences : public TestFixture {
+   public:
+    void SetUp() override {
+        last_event = UINT16_MAX;
+    }
+};
+
+TEST_F(LeaderSequences, CompletesUniqueSequenceWithoutTimeout) {
+    TestDriver driver;
+    KeymapKey  key_leader(0, 0, 0, QK_LEADER);
+    KeymapKey  key_g(0, 1, 0, KC_G);
+    KeymapKey  key_s(0, 2, 0, KC_S);
+    set_keymap({key_leader, key_g, key_s});
+
+    InSequence s;
+    EXPECT_REPORT(driver, (KC_F1));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_leader);
+    tap_key(key_g);
+    tap_key(key_s);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(leader_sequence_active(), false);
+    EXPECT_EQ(last_event, 0);
+}
+
+TEST_F(LeaderSequences, WaitsForTimeoutWhileLongerSequenceCanMatch) {
+    TestDriver driver;
+    KeymapKey  key_leader(0, 0, 0, QK_LEADER);
+    KeymapKey  key_g(0, 1, 0, KC_G);
+    KeymapKey  key_d(0, 2, 0, KC_D);
+    set_keymap({key_leader, key_g, key_d});
+
+    InSequence s;
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_leader);
+    tap_key(key_g);
+    tap_key(key_d);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(leader_sequence_active(), true);
+
+    EXPECT_REPORT(driver, (KC_F2));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(300);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(last_event, 1);
+
+    // Typing the longer sequence completes it right away
+    EXPECT_REPORT(driver, (KC_F3));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_leader);
+    tap_key(key_g);
+    tap_key(key_d);
+    tap_key(key_d);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(leader_sequence_active(), false);
+    EXPECT_EQ(last_event, 2);
+}
+
+TEST_F(LeaderSequences, SequencesAreLongerThanTheBuffer) {
+    TestDriver driver;
+    KeymapKey  key_leader(0, 0, 0, QK_LEADER);
+    set_keymap({key_leader});
+
+    InSequence s;
+    EXPECT_REPORT(driver, (KC_F4));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_leader);
+    for (uint16_t keycode : {KC_L, KC_O, KC_N, KC_G, KC_E, KC_S, KC_T, KC_K, KC_E, KC_Y}) {
+        EXPECT_EQ(leader_sequence_active(), true);
+        keyrecord_t record   = {};
+        record.event.pressed = true;
+        process_leader(keycode, &record);
+    }
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(leader_sequence_active(), false);
+    EXPECT_EQ(last_event, 3);
+}
+
+TEST_F(LeaderSequences, ActionSequenceOnlyCallsEvent) {
+    TestDriver driver;
+    KeymapKey  key_leader(0, 0, 0, QK_LEADER);
+    KeymapKey  key_x(0, 1, 0, KC_X);
+    set_keymap({key_leader, key_x});
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_leader);
+    tap_key(key_x);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(leader_sequence_active(), false);
+    EXPECT_EQ(last_event, 5);
+}
+
+TEST_F(LeaderSequences, OtherSequencesReachLeaderEndUser) {
+    TestDriver driver;
+    KeymapKey  key_leader(0, 0, 0, QK_LEADER);
+    KeymapKey  key_a(0, 1, 0, KC_A);
+    KeymapKey  key_b(0, 2, 0, KC_B);
+    KeymapKey  key_g(0, 3, 0, KC_G);
+    set_keymap({key_leader, key_a, key_b, key_g});
+
+    InSequence s;
+    EXPECT_REPORT(driver, (KC_2));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_leader);
+    tap_key(key_a);
+    tap_key(key_b);
+    idle_for(300);
+    VERIFY_AND_CLEAR(driver);
+
+    // Only the start of a sequence from the table
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_leader);
+    tap_key(key_g);
+    idle_for(300);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(last_event, UINT16_MAX);
+}
+
+class ManyLeaderSequences : public TestFixture {
+   public:
+    void SetUp() override {
+        if (many_sequences.empty()) {
+            uint32_t state = 0x2545F491;
+            auto     next  = [&state]() {
+                state ^= state << 13;
+                state ^= state >> 17;
+                state ^= state << 5;
+                return state;
+            };
+
+            while (many_sequences.size() < MANY_SEQUENCES) {
+                std::vector<uint16_t> sequence(3 + next() % 6);
+                for (uint16_t &key : sequence) {
+                    key = KC_A + next() % 26;
+                }
+
+                bool is_prefix = false;
+                for (const auto &other : many_sequences) {
+                    size_t common = std::min(other.size(), sequence.size());
+                    is_prefix |= std::equal(other.begin(), other.begin() + common, sequence.begin());
+                }
+                if (!is_prefix) {
+                    many_sequences.push_back(sequence);
+                }
+            }
+        }
+
+        use_many_sequences = true;
+        leader_sequences_index_rebuild();
+        last_event = UINT16_MAX;
+    }
+
+    void TearDown() override {
+        use_many_sequences = false;
+        leader_sequences_index_rebuild();
+    }
+};
+
+TEST_F(ManyLeaderSequences, CompletesEverySequence) {
+    for (uint16_t i = 0; i < MANY_SEQUENCES; i++) {
+        leader_start();
+        for (size_t k = 0; k < many_sequences[i].size(); k++) {
+            ASSERT_FALSE(leader_sequence_complete()) << "sequence " << i;
+            ASSERT_TRUE(leader_sequence_add(many_sequences[i][k])) << "sequence " << i;
+        }
+        ASSERT_TRUE(leader_sequence_complete()) << "sequence " << i;
+        leader_end();
+        EXPECT_EQ(last_event, i);
+    }
+}
+
+TEST_F(ManyLeaderSequences, OnlyVisitsTheCurrentNode) {
+    unsigned max_lookups = 0;
+
+    for (uint16_t i = 0; i < MANY_SEQUENCES; i++) {
+        leader_start();
+        for (uint16_t key : many_sequences[i]) {
+            key_lookups = 0;
+            leader_sequence_add(key);
+            max_lookups = std::max(max_lookups, key_lookups);
+        }
+        leader_end();
+    }
+
+#if LEADER_SEQUENCES_INDEX_SIZE >= MANY_SEQUENCES
+    // Two binary searches over the sequences, and whether the first one ends here
+    EXPECT_LE(max_lookups, 2 * 10 + 1);
+#else
+    EXPECT_GE(max_lookups, MANY_SEQUENCES);
+#endif
+}
+
+TEST_F(ManyLeaderSequences, Benchmark) {
+    const int rounds = 100;
+    unsigned  keys   = 0;
+
+    // Build the index outside of the measurement
+    leader_start();
+    leader_end();
+
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+        for (uint16_t i = 0; i < MANY_SEQUENCES; i++) {
+            leader_start();
+            for (uint16_t key : many_sequences[i]) {
+                leader_sequence_add(key);
+                keys++;
+            }
+            leader_end();
+        }
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    printf("%u sequences: %.0f ns per key\n", MANY_SEQUENCES, elapsed * 1e9 / keys);
+}
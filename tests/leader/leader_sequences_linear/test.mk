@@ -0,0 +1,10 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+LEADER_ENABLE = yes
+LEADER_SEQUENCES_ENABLE = yes
+
+INTROSPECTION_KEYMAP_C = ../leader_sequences/leader_sequence_table.c
+
+# Same behaviour when the sequences do not fit in the index
+SRC += ../leader_sequences.c ../leader_sequences/test_leader_sequences.cpp
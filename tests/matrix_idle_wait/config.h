@@ -0,0 +1,9 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define MATRIX_IDLE_WAIT_TIMEOUT 500
+#define MATRIX_IDLE_WAIT_MAX 100
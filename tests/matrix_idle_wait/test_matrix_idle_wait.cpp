@@ -0,0 +1,126 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keycode.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "deferred_exec.h"
+void wakeup_simulate_edge(uint32_t time);
+void wakeup_clear_edge(void);
+}
+
+using testing::_;
+
+class MatrixIdleWait : public TestFixture {
+   protected:
+    void SetUp() override {
+        wakeup_clear_edge();
+        set_keymap({key_a});
+
+        // Establish recent activity so that every test starts from an active keyboard
+        TestDriver driver;
+        EXPECT_REPORT(driver, (KC_A));
+        EXPECT_EMPTY_REPORT(driver);
+        tap_key(key_a);
+        VERIFY_AND_CLEAR(driver);
+    }
+
+    KeymapKey key_a = KeymapKey(0, 0, 0, KC_A);
+};
+
+TEST_F(MatrixIdleWait, DoesNotWaitWhileActive) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    uint32_t start = timer_read32();
+    keyboard_task();
+    EXPECT_EQ(timer_read32(), start);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(MatrixIdleWait, WaitsForAtMostMaxOnceIdle) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    idle_for(MATRIX_IDLE_WAIT_TIMEOUT);
+
+    uint32_t start = timer_read32();
+    keyboard_task();
+    EXPECT_EQ(timer_read32() - start, MATRIX_IDLE_WAIT_MAX);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(MatrixIdleWait, EdgeEndsWaitEarly) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    idle_for(MATRIX_IDLE_WAIT_TIMEOUT);
+
+    uint32_t start = timer_read32();
+    wakeup_simulate_edge(start + 30);
+    keyboard_task();
+    EXPECT_EQ(timer_read32() - start, 30);
+    VERIFY_AND_CLEAR(driver);
+
+    // The switch behind the edge is scanned without any further wait
+    start = timer_read32();
+    key_a.press();
+    EXPECT_REPORT(driver, (KC_A));
+    keyboard_task();
+    EXPECT_EQ(timer_read32(), start);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(MatrixIdleWait, DoesNotWaitWhileKeyIsHeld) {
+    TestDriver driver;
+
+    EXPECT_REPORT(driver, (KC_A));
+    key_a.press();
+    idle_for(MATRIX_IDLE_WAIT_TIMEOUT * 2);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    uint32_t start = timer_read32();
+    keyboard_task();
+    EXPECT_EQ(timer_read32(), start);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+static uint32_t deferred_callback_time = 0;
+
+static uint32_t record_callback_time(uint32_t trigger_time, void *cb_arg) {
+    deferred_callback_time = timer_read32();
+    return 0;
+}
+
+TEST_F(MatrixIdleWait, WaitEndsWhenDeferredExecutorIsDue) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    idle_for(MATRIX_IDLE_WAIT_TIMEOUT);
+
+    uint32_t start         = timer_read32();
+    deferred_callback_time = 0;
+    EXPECT_NE(defer_exec(40, record_callback_time, NULL), INVALID_DEFERRED_TOKEN);
+    EXPECT_EQ(deferred_exec_time_until_next(), 40);
+
+    keyboard_task();
+    EXPECT_EQ(timer_read32() - start, 40);
+    EXPECT_EQ(deferred_exec_time_until_next(), 0);
+
+    deferred_exec_task();
+    EXPECT_EQ(deferred_callback_time, start + 40);
+    EXPECT_EQ(deferred_exec_time_until_next(), UINT32_MAX);
+    VERIFY_AND_CLEAR(driver);
+}
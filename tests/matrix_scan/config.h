@@ -0,0 +1,12 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+// Large synthetic matrix to exercise the changed row/column walk.
+#undef MATRIX_ROWS
+#define MATRIX_ROWS 20
+#undef MATRIX_COLS
+#define MATRIX_COLS 20
@@ -0,0 +1,124 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <vector>
+#include "keycode.h"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::AnyNumber;
+
+namespace {
+std::vector<keyevent_t> recorded_events;
+} // namespace
+
+extern "C" bool process_record_user(uint16_t keycode, keyrecord_t *record) {
+    recorded_events.push_back(record->event);
+    return true;
+}
+
+class MatrixScan : public TestFixture {
+   protected:
+    void SetUp() override {
+        recorded_events.clear();
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                add_key(KeymapKey(0, col, row, KC_NO));
+            }
+        }
+    }
+
+    void press_all_keys() {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                press_key(col, row);
+            }
+        }
+    }
+};
+
+TEST_F(MatrixScan, ChangesAreDispatchedInRowAndColumnOrder) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    press_key(7, 15);
+    press_key(19, 0);
+    press_key(0, 19);
+    press_key(3, 15);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    ASSERT_EQ(recorded_events.size(), 4);
+    const keypos_t expected[] = {{19, 0}, {3, 15}, {7, 15}, {0, 19}};
+    for (size_t i = 0; i < recorded_events.size(); i++) {
+        EXPECT_EQ(recorded_events[i].key.col, expected[i].col);
+        EXPECT_EQ(recorded_events[i].key.row, expected[i].row);
+        EXPECT_TRUE(recorded_events[i].pressed);
+    }
+
+    recorded_events.clear();
+    EXPECT_NO_REPORT(driver);
+    release_key(3, 15);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    ASSERT_EQ(recorded_events.size(), 1);
+    EXPECT_EQ(recorded_events[0].key.col, 3);
+    EXPECT_EQ(recorded_events[0].key.row, 15);
+    EXPECT_FALSE(recorded_events[0].pressed);
+}
+
+TEST_F(MatrixScan, EveryKeyOfAFullMatrixIsReported) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    press_all_keys();
+    run_one_scan_loop();
+    EXPECT_EQ(recorded_events.size(), MATRIX_ROWS * MATRIX_COLS);
+
+    clear_all_keys();
+    run_one_scan_loop();
+    EXPECT_EQ(recorded_events.size(), 2 * MATRIX_ROWS * MATRIX_COLS);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(MatrixScan, BenchmarkSingleKeyChanges) {
+    TestDriver     driver;
+    const unsigned iterations = 20000;
+
+    EXPECT_NO_REPORT(driver);
+    const auto start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < iterations; i++) {
+        const uint8_t row = i % MATRIX_ROWS;
+        const uint8_t col = (i / MATRIX_ROWS) % MATRIX_COLS;
+        press_key(col, row);
+        keyboard_task();
+        release_key(col, row);
+        keyboard_task();
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    VERIFY_AND_CLEAR(driver);
+
+    ASSERT_EQ(recorded_events.size(), 2 * iterations);
+    std::cout << "[ BENCHMARK] " << MATRIX_ROWS << "x" << MATRIX_COLS << " single key changes: " << recorded_events.size() / elapsed.count() << " events/s" << std::endl;
+}
+
+TEST_F(MatrixScan, BenchmarkFullMatrixChanges) {
+    TestDriver     driver;
+    const unsigned iterations = 100;
+
+    EXPECT_NO_REPORT(driver);
+    const auto start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < iterations; i++) {
+        press_all_keys();
+        keyboard_task();
+        clear_all_keys();
+        keyboard_task();
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    VERIFY_AND_CLEAR(driver);
+
+    ASSERT_EQ(recorded_events.size(), 2 * iterations * MATRIX_ROWS * MATRIX_COLS);
+    std::cout << "[ BENCHMARK] " << MATRIX_ROWS << "x" << MATRIX_COLS << " full matrix changes: " << recorded_events.size() / elapsed.count() << " events/s" << std::endl;
+}
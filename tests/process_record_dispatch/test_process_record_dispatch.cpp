@@ -0,0 +1,68 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <cstdio>
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::AnyNumber;
+using testing::InSequence;
+
+class ProcessRecordDispatch : public TestFixture {};
+
+TEST_F(ProcessRecordDispatch, RoutesRangeSpecificKeycodes) {
+    TestDriver driver;
+    KeymapKey  key_grave_esc(0, 0, 0, QK_GRAVE_ESCAPE);
+    KeymapKey  key_lower(0, 1, 0, QK_TRI_LAYER_LOWER);
+    KeymapKey  key_a(0, 2, 0, KC_A);
+    set_keymap({key_grave_esc, key_lower, key_a});
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_ESCAPE));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_grave_esc);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    key_lower.press();
+    run_one_scan_loop();
+    EXPECT_TRUE(layer_state_is(get_tri_layer_lower_layer()));
+    key_lower.release();
+    run_one_scan_loop();
+    EXPECT_FALSE(layer_state_is(get_tri_layer_lower_layer()));
+    VERIFY_AND_CLEAR(driver);
+
+    /* Handlers that observe every key still see plain keycodes. */
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_a);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(get_last_keycode(), KC_A);
+}
+
+TEST_F(ProcessRecordDispatch, Benchmark) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 0, 0, KC_A);
+    set_keymap({key_a});
+    const int events = 20000;
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < events / 2; i++) {
+        keyrecord_t record = {};
+        record.event.key   = key_a.position;
+        record.event.type  = KEY_EVENT;
+        record.event.time  = timer_read();
+
+        record.event.pressed = true;
+        process_record_quantum(&record);
+        record.event.pressed = false;
+        process_record_quantum(&record);
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    printf("process_record_quantum: %.0f ns per event\n", elapsed * 1e9 / events);
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,9 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+RGB_MATRIX_ENABLE = yes
+RGB_MATRIX_DRIVER = custom
+
+# Same frames and colors as without the lookup tables
+SRC += ../test_rgb_matrix_effects.cpp
+SRC += ../test_hsv_to_rgb.cpp
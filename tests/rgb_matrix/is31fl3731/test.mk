@@ -0,0 +1,8 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+RGB_MATRIX_ENABLE = yes
+RGB_MATRIX_DRIVER = is31fl3731
+
+# Tests do not build QUANTUM_LIB_SRC, pull in the mock from platforms/test/drivers
+SRC += i2c_master.c
@@ -0,0 +1,124 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstdio>
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "rgb_matrix.h"
+#include "i2c_master.h"
+}
+
+/* 48 LEDs filling the 144 PWM registers of frame 1 in order, LED n on registers 3n to 3n + 2. */
+#define PWM_REGISTER_COUNT 144
+
+// clang-format off
+#define LED(n) {0, 3 * (n), 3 * (n) + 1, 3 * (n) + 2}
+const is31fl3731_led_t PROGMEM g_is31fl3731_leds[RGB_MATRIX_LED_COUNT] = {
+    LED(0),  LED(1),  LED(2),  LED(3),  LED(4),  LED(5),  LED(6),  LED(7),  LED(8),  LED(9),  LED(10), LED(11),
+    LED(12), LED(13), LED(14), LED(15), LED(16), LED(17), LED(18), LED(19), LED(20), LED(21), LED(22), LED(23),
+    LED(24), LED(25), LED(26), LED(27), LED(28), LED(29), LED(30), LED(31), LED(32), LED(33), LED(34), LED(35),
+    LED(36), LED(37), LED(38), LED(39), LED(40), LED(41), LED(42), LED(43), LED(44), LED(45), LED(46), LED(47),
+};
+// clang-format on
+
+led_config_t g_led_config;
+
+// The selected page and the frame 1 PWM registers of the chip
+static uint8_t chip_page;
+static uint8_t chip_pwm[PWM_REGISTER_COUNT];
+
+extern "C" {
+void i2c_test_write_register_kb(uint8_t devaddr, uint16_t regaddr, const uint8_t *data, uint16_t length) {
+    for (uint16_t i = 0; i < length; i++, regaddr++) {
+        if (regaddr == IS31FL3731_REG_COMMAND) {
+            chip_page = data[i];
+        } else if (chip_page == IS31FL3731_COMMAND_FRAME_1 && regaddr >= IS31FL3731_FRAME_REG_PWM && regaddr < IS31FL3731_FRAME_REG_PWM + PWM_REGISTER_COUNT) {
+            chip_pwm[regaddr - IS31FL3731_FRAME_REG_PWM] = data[i];
+        }
+    }
+}
+}
+
+class Is31fl3731 : public TestFixture {
+   public:
+    void SetUp() override {
+        // Keep rgb_matrix_task() from touching the LEDs, then start from black on both sides
+        rgb_matrix_disable_noeeprom();
+        rgb_matrix_driver.set_color_all(0, 0, 0);
+        rgb_matrix_driver.flush();
+        memset(expected_pwm, 0, sizeof(expected_pwm));
+        ASSERT_EQ(memcmp(chip_pwm, expected_pwm, sizeof(chip_pwm)), 0);
+        i2c_test_stats = {};
+    }
+
+    void SetColor(uint8_t index, uint8_t red, uint8_t green, uint8_t blue) {
+        rgb_matrix_driver.set_color(index, red, green, blue);
+        expected_pwm[3 * index]     = red;
+        expected_pwm[3 * index + 1] = green;
+        expected_pwm[3 * index + 2] = blue;
+    }
+
+    void Flush(void) {
+        rgb_matrix_driver.flush();
+        ASSERT_EQ(memcmp(chip_pwm, expected_pwm, sizeof(chip_pwm)), 0);
+    }
+
+    uint8_t expected_pwm[PWM_REGISTER_COUNT];
+};
+
+TEST_F(Is31fl3731, NothingIsSentWithoutChanges) {
+    Flush();
+    EXPECT_EQ(i2c_test_stats.transfers, 0);
+
+    // Setting the same color again does not count as a change
+    SetColor(5, 0, 0, 0);
+    Flush();
+    EXPECT_EQ(i2c_test_stats.transfers, 0);
+}
+
+TEST_F(Is31fl3731, SendsOnlyTheChangedTransfer) {
+    SetColor(2, 10, 20, 30);
+    Flush();
+    EXPECT_EQ(i2c_test_stats.transfers, 1);
+    EXPECT_EQ(i2c_test_stats.bytes, 2 + 16);
+}
+
+TEST_F(Is31fl3731, MergesAdjacentTransfers) {
+    // Registers 15 to 17 straddle the first two transfers
+    SetColor(5, 1, 2, 3);
+    Flush();
+    EXPECT_EQ(i2c_test_stats.transfers, 1);
+    EXPECT_EQ(i2c_test_stats.bytes, 2 + 32);
+
+    // Registers 0 and 48, in the first and fourth transfers
+    i2c_test_stats = {};
+    SetColor(0, 4, 5, 6);
+    SetColor(16, 7, 8, 9);
+    Flush();
+    EXPECT_EQ(i2c_test_stats.transfers, 2);
+    EXPECT_EQ(i2c_test_stats.bytes, 2 * (2 + 16));
+}
+
+TEST_F(Is31fl3731, ChipMatchesAfterRandomChanges) {
+    const uint32_t frames = 1000;
+    uint32_t       state  = 0x2545F491;
+    auto           next   = [&state]() {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    };
+
+    for (uint32_t frame = 0; frame < frames; frame++) {
+        for (uint32_t changes = next() % 6; changes > 0; changes--) {
+            SetColor(next() % RGB_MATRIX_LED_COUNT, next(), next(), next());
+        }
+        Flush();
+    }
+
+    // Every frame used to send all nine transfers of 16 bytes
+    printf("%u PWM registers: %.1f bytes per frame, %u before\n", PWM_REGISTER_COUNT, (double)i2c_test_stats.bytes / frames, 9 * (2 + 16));
+    EXPECT_LT(i2c_test_stats.bytes, frames * 9 * (2 + 16));
+}
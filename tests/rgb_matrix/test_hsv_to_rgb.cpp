@@ -0,0 +1,128 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "color.h"
+#include "led_tables.h"
+#include "progmem.h"
+}
+
+/* hsv_to_rgb_impl() as it was before the lookup tables. */
+static RGB reference_hsv_to_rgb(HSV hsv, bool use_cie) {
+    RGB      rgb;
+    uint8_t  region, remainder, p, q, t;
+    uint16_t h, s, v;
+
+    v = use_cie ? pgm_read_byte(&CIE1931_CURVE[hsv.v]) : hsv.v;
+    if (hsv.s == 0) {
+        rgb.r = rgb.g = rgb.b = v;
+        return rgb;
+    }
+
+    h = hsv.h;
+    s = hsv.s;
+
+    region    = h * 6 / 255;
+    remainder = (h * 2 - region * 85) * 3;
+
+    p = (v * (255 - s)) >> 8;
+    q = (v * (255 - ((s * remainder) >> 8))) >> 8;
+    t = (v * (255 - ((s * (255 - remainder)) >> 8))) >> 8;
+
+    switch (region) {
+        case 6:
+        case 0:
+            rgb.r = v, rgb.g = t, rgb.b = p;
+            break;
+        case 1:
+            rgb.r = q, rgb.g = v, rgb.b = p;
+            break;
+        case 2:
+            rgb.r = p, rgb.g = v, rgb.b = t;
+            break;
+        case 3:
+            rgb.r = p, rgb.g = q, rgb.b = v;
+            break;
+        case 4:
+            rgb.r = t, rgb.g = p, rgb.b = v;
+            break;
+        default:
+            rgb.r = v, rgb.g = p, rgb.b = q;
+            break;
+    }
+    return rgb;
+}
+
+static bool operator==(const RGB &a, const RGB &b) {
+    return a.r == b.r && a.g == b.g && a.b == b.b;
+}
+
+/* A frame of 120 LEDs: a rainbow at full saturation and value, then a splash fading with distance. */
+static std::vector<HSV> frame_colors(uint8_t time) {
+    std::vector<HSV> colors;
+    for (uint8_t i = 0; i < 120; i++) {
+        if (i < 60) {
+            colors.push_back({(uint8_t)(i * 4 + time), 255, 255});
+        } else {
+            colors.push_back({time, 255, (uint8_t)(255 - (i - 60) * 4)});
+        }
+    }
+    return colors;
+}
+
+TEST(HsvToRgb, MatchesReferenceForEveryColor) {
+    for (uint32_t i = 0; i < (1 << 24); i++) {
+        HSV hsv = {(uint8_t)(i >> 16), (uint8_t)(i >> 8), (uint8_t)i};
+        ASSERT_TRUE(hsv_to_rgb(hsv) == reference_hsv_to_rgb(hsv, true)) << "hsv " << (int)hsv.h << ", " << (int)hsv.s << ", " << (int)hsv.v;
+        ASSERT_TRUE(hsv_to_rgb_nocie(hsv) == reference_hsv_to_rgb(hsv, false)) << "hsv " << (int)hsv.h << ", " << (int)hsv.s << ", " << (int)hsv.v;
+    }
+}
+
+TEST(HsvToRgb, BatchMatchesOneByOne) {
+    std::vector<HSV> colors;
+    for (uint32_t i = 0; i < 8192; i++) {
+        // Runs of every length sharing saturation and value, grays among them
+        uint8_t run = (uint8_t)(i / 64);
+        colors.push_back({(uint8_t)(i * 7), (uint8_t)(run % 5 == 0 ? 0 : run * 37), (uint8_t)(run * 91)});
+    }
+    for (uint8_t time = 0; time < 8; time++) {
+        auto frame = frame_colors(time * 32);
+        colors.insert(colors.end(), frame.begin(), frame.end());
+    }
+
+    std::vector<RGB> batch(colors.size());
+    hsv_to_rgb_batch(colors.data(), batch.data(), colors.size());
+    for (size_t i = 0; i < colors.size(); i++) {
+        ASSERT_TRUE(batch[i] == hsv_to_rgb(colors[i])) << "color " << i;
+    }
+}
+
+TEST(HsvToRgb, Benchmark) {
+    const int        frames = 10000;
+    std::vector<HSV> colors = frame_colors(0);
+    std::vector<RGB> rgb(colors.size());
+
+    auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; frame++) {
+        colors[frame % colors.size()].h++;
+        for (size_t i = 0; i < colors.size(); i++) {
+            rgb[i] = hsv_to_rgb(colors[i]);
+        }
+    }
+    double one_by_one = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; frame++) {
+        colors[frame % colors.size()].h++;
+        hsv_to_rgb_batch(colors.data(), rgb.data(), colors.size());
+    }
+    double batch = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    printf("%zu LEDs: %.0f ns per frame one by one, %.0f ns batched\n", colors.size(), one_by_one * 1e9 / frames, batch * 1e9 / frames);
+}
@@ -0,0 +1,153 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "rgb_matrix.h"
+#include "lib/lib8tion/lib8tion.h"
+
+void advance_time(uint32_t ms);
+}
+
+/* 120 LEDs on a 15 by 8 grid spanning the whole 224 by 64 area, the matrix keys in the middle of it. */
+#define LED_COLS 15
+#define LED_ROWS 8
+
+led_config_t g_led_config;
+
+static RGB      led_colors[RGB_MATRIX_LED_COUNT];
+static uint32_t flushes;
+static uint32_t frame_hash;
+
+static bool init_led_config(void) {
+    memset(g_led_config.matrix_co, NO_LED, sizeof(g_led_config.matrix_co));
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        uint8_t row             = i / LED_COLS;
+        uint8_t col             = i % LED_COLS;
+        g_led_config.point[i].x = col * 224 / (LED_COLS - 1);
+        g_led_config.point[i].y = row * 64 / LED_ROWS;
+        g_led_config.flags[i]   = LED_FLAG_UNDERGLOW;
+        if (row >= 2 && row < 2 + MATRIX_ROWS && col >= 2 && col < 2 + MATRIX_COLS) {
+            g_led_config.matrix_co[row - 2][col - 2] = i;
+            g_led_config.flags[i]                    = LED_FLAG_KEYLIGHT;
+        }
+    }
+    return true;
+}
+
+// Before keyboard_init() runs rgb_matrix_init()
+static bool led_config_ready = init_led_config();
+
+extern "C" {
+static void test_init(void) {}
+
+static void test_set_color(int index, uint8_t r, uint8_t g, uint8_t b) {
+    led_colors[index] = {r, g, b};
+}
+
+static void test_set_color_all(uint8_t r, uint8_t g, uint8_t b) {
+    for (RGB &color : led_colors) {
+        color = {r, g, b};
+    }
+}
+
+static void test_flush(void) {
+    const uint8_t *bytes = (const uint8_t *)led_colors;
+    for (size_t i = 0; i < sizeof(led_colors); i++) {
+        frame_hash = (frame_hash ^ bytes[i]) * 16777619;
+    }
+    flushes++;
+}
+
+const rgb_matrix_driver_t rgb_matrix_driver = {test_init, test_set_color, test_set_color_all, test_flush};
+}
+
+class RgbMatrixEffects : public TestFixture {
+   public:
+    void SetUp() override {
+        ASSERT_TRUE(led_config_ready);
+        rgb_matrix_enable_noeeprom();
+        rgb_matrix_sethsv_noeeprom(HSV_RED);
+        rgb_matrix_set_speed_noeeprom(RGB_MATRIX_DEFAULT_SPD);
+        random16_set_seed(1337);
+        frame_hash = 2166136261;
+    }
+
+    // Renders and flushes one frame, tapping a key every few frames for the reactive effects.
+    void RenderFrame(uint32_t frame, uint32_t tap_every = 8) {
+        if (frame % tap_every == 0) {
+            uint8_t key = frame / tap_every * 7 % (MATRIX_ROWS * MATRIX_COLS);
+            rgb_matrix_handle_key_event(key / MATRIX_COLS, key % MATRIX_COLS, true);
+            rgb_matrix_handle_key_event(key / MATRIX_COLS, key % MATRIX_COLS, false);
+        }
+        advance_time(RGB_MATRIX_LED_FLUSH_LIMIT);
+        for (uint32_t target = flushes + 1; flushes != target;) {
+            rgb_matrix_task();
+        }
+    }
+
+    void RenderEffects(const std::vector<uint8_t> &modes, uint32_t frames, uint32_t tap_every = 8) {
+        for (uint8_t mode : modes) {
+            rgb_matrix_mode_noeeprom(mode);
+            for (uint32_t frame = 0; frame < frames; frame++) {
+                RenderFrame(frame, tap_every);
+            }
+        }
+    }
+
+    static std::vector<uint8_t> AllEffects(void) {
+        std::vector<uint8_t> modes;
+        for (uint8_t mode = RGB_MATRIX_NONE + 1; mode < RGB_MATRIX_EFFECT_MAX; mode++) {
+            modes.push_back(mode);
+        }
+        return modes;
+    }
+
+    // The effects built on the distance and angle of each LED from the center
+    static std::vector<uint8_t> GeometryEffects(void) {
+        return {RGB_MATRIX_BAND_PINWHEEL_SAT, RGB_MATRIX_BAND_PINWHEEL_VAL, RGB_MATRIX_BAND_SPIRAL_SAT, RGB_MATRIX_BAND_SPIRAL_VAL, RGB_MATRIX_CYCLE_OUT_IN, RGB_MATRIX_CYCLE_PINWHEEL, RGB_MATRIX_CYCLE_SPIRAL};
+    }
+
+    // The effects spreading out from each hit
+    static std::vector<uint8_t> SplashEffects(void) {
+        return {RGB_MATRIX_TYPING_HEATMAP, RGB_MATRIX_SOLID_REACTIVE_MULTIWIDE, RGB_MATRIX_SOLID_REACTIVE_MULTICROSS, RGB_MATRIX_SOLID_REACTIVE_MULTINEXUS, RGB_MATRIX_MULTISPLASH, RGB_MATRIX_SOLID_MULTISPLASH};
+    }
+};
+
+TEST_F(RgbMatrixEffects, EveryEffectRendersTheSameFrames) {
+    RenderEffects(AllEffects(), 64);
+    EXPECT_EQ(frame_hash, 3495175375u);
+}
+
+TEST_F(RgbMatrixEffects, FastTypingRendersTheSameFrames) {
+    RenderEffects(SplashEffects(), 256, 1);
+    EXPECT_EQ(frame_hash, 3859742184u);
+}
+
+TEST_F(RgbMatrixEffects, Benchmark) {
+    const uint32_t frames = 1000;
+
+    for (const auto &modes : {GeometryEffects(), AllEffects()}) {
+        auto start = std::chrono::steady_clock::now();
+        RenderEffects(modes, frames);
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        printf("%zu effects, %u LEDs: %.0f ns per frame\n", modes.size(), RGB_MATRIX_LED_COUNT, elapsed * 1e9 / (modes.size() * frames));
+    }
+}
+
+TEST_F(RgbMatrixEffects, FastTypingBenchmark) {
+    const uint32_t frames = 1000;
+
+    // A key every frame, so every remembered hit is recent
+    auto start = std::chrono::steady_clock::now();
+    RenderEffects(SplashEffects(), frames, 1);
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    printf("%zu effects, %u LEDs, %u hits: %.0f ns per frame\n", SplashEffects().size(), RGB_MATRIX_LED_COUNT, LED_HITS_TO_REMEMBER, elapsed * 1e9 / (SplashEffects().size() * frames));
+}
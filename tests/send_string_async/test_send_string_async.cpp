@@ -0,0 +1,124 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+class SendStringAsync : public TestFixture {
+   protected:
+    void TearDown() override {
+        send_string_async_cancel();
+        TestFixture::TearDown();
+    }
+};
+
+TEST_F(SendStringAsync, TypesInTheBackground) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_NO_REPORT(driver);
+    EXPECT_TRUE(send_string_async("aB"));
+    EXPECT_TRUE(send_string_async_is_busy());
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_B));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(10);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_FALSE(send_string_async_is_busy());
+}
+
+TEST_F(SendStringAsync, HonoursCodesAndDelays) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_TRUE(send_string_async_with_delay(SS_TAP(X_ENTER) SS_DELAY(50) SS_DOWN(X_LCTL) "c" SS_UP(X_LCTL), 0));
+
+    EXPECT_REPORT(driver, (KC_ENTER));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(10);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    idle_for(35);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LEFT_CTRL));
+    EXPECT_REPORT(driver, (KC_LEFT_CTRL, KC_C));
+    EXPECT_REPORT(driver, (KC_LEFT_CTRL));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(20);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, KeepsProcessingKeysDuringPlayback) {
+    TestDriver driver;
+    KeymapKey  key_x(0, 0, 0, KC_X);
+    set_keymap({key_x});
+    InSequence s;
+
+    EXPECT_TRUE(send_string_async(SS_DELAY(100) "a"));
+
+    EXPECT_REPORT(driver, (KC_X));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(10);
+    tap_key(key_x);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(100);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, CancelReleasesHeldKeys) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_TRUE(send_string_async_with_delay("AB", 10));
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    idle_for(5);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    send_string_async_cancel();
+    EXPECT_FALSE(send_string_async_is_busy());
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    idle_for(100);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, RejectsStringsThatDoNotFit) {
+    TestDriver driver;
+    InSequence s;
+
+    /* Each string takes its length plus two bytes of the 32 byte queue. */
+    EXPECT_FALSE(send_string_async("abcdefghijklmnopqrstuvwxyzabcdef"));
+    EXPECT_FALSE(send_string_async_is_busy());
+    EXPECT_TRUE(send_string_async("abcdefghijklmn"));
+    EXPECT_TRUE(send_string_async("opqrstuvwxyz"));
+    EXPECT_FALSE(send_string_async("ab"));
+
+    for (uint8_t keycode = KC_A; keycode <= KC_Z; keycode++) {
+        EXPECT_REPORT(driver, (keycode));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    idle_for(40);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_TRUE(send_string_async("a"));
+    idle_for(5);
+    VERIFY_AND_CLEAR(driver);
+}
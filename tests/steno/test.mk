@@ -0,0 +1,5 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+STENO_ENABLE = yes
+VIRTSER_ENABLE = yes
@@ -0,0 +1,161 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::ElementsAre;
+
+static std::vector<uint8_t> serial_output;
+
+extern "C" {
+void virtser_init(void) {}
+
+void virtser_send(const uint8_t byte) {
+    serial_output.push_back(byte);
+}
+}
+
+class Steno : public TestFixture {
+   public:
+    void SetUp() override {
+        serial_output.clear();
+    }
+
+    void TearDown() override {
+        steno_set_mode(STENO_MODE_GEMINI);
+    }
+
+    // Presses all keys of a stroke, then releases them, without running the main loop in between
+    static void stroke(std::initializer_list<uint16_t> keycodes) {
+        keyrecord_t record = {};
+        record.event.type  = KEY_EVENT;
+        for (bool pressed : {true, false}) {
+            for (uint16_t keycode : keycodes) {
+                record.event.pressed = pressed;
+                process_steno(keycode, &record);
+            }
+        }
+    }
+};
+
+TEST_F(Steno, SendsGeminiPacketOnRelease) {
+    TestDriver driver;
+    KeymapKey  key_e(0, 0, 0, STN_E);
+    KeymapKey  key_u(0, 1, 0, STN_U);
+    KeymapKey  key_b(0, 2, 0, STN_BR);
+    KeymapKey  key_g(0, 3, 0, STN_GR);
+    set_keymap({key_e, key_u, key_b, key_g});
+
+    EXPECT_NO_REPORT(driver);
+    for (auto key : {key_e, key_u, key_b, key_g}) {
+        key.press();
+        run_one_scan_loop();
+    }
+    for (auto key : {key_e, key_u, key_b}) {
+        key.release();
+        run_one_scan_loop();
+    }
+    EXPECT_TRUE(serial_output.empty());
+
+    key_g.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // EUBG
+    EXPECT_THAT(serial_output, ElementsAre(0b10000000, 0b00000000, 0b00000000, 0b00001100, 0b00101000, 0b00000000));
+}
+
+TEST_F(Steno, SendsBoltPacketWithoutEmptyGroups) {
+    TestDriver driver;
+    KeymapKey  key_w(0, 0, 0, STN_WL);
+    KeymapKey  key_a(0, 1, 0, STN_A);
+    KeymapKey  key_z(0, 2, 0, STN_ZR);
+    set_keymap({key_w, key_a, key_z});
+
+    steno_set_mode(STENO_MODE_BOLT);
+
+    EXPECT_NO_REPORT(driver);
+    for (auto key : {key_w, key_a, key_z}) {
+        key.press();
+        run_one_scan_loop();
+    }
+    for (auto key : {key_w, key_a, key_z}) {
+        key.release();
+        run_one_scan_loop();
+    }
+    VERIFY_AND_CLEAR(driver);
+
+    // WAZ, then the null byte
+    EXPECT_THAT(serial_output, ElementsAre(0b00010000, 0b01000010, 0b11001000, 0));
+}
+
+#ifdef STENO_OUTPUT_QUEUE
+TEST_F(Steno, QueuedStrokesGoOutOnePerLoop) {
+    TestDriver driver;
+
+    stroke({STN_E, STN_U, STN_BR, STN_GR});
+    stroke({STN_WL, STN_A, STN_ZR});
+    EXPECT_TRUE(serial_output.empty());
+    EXPECT_EQ(steno_output_queue_pending(), 2 * (1 + 6));
+
+    run_one_scan_loop();
+    EXPECT_THAT(serial_output, ElementsAre(0b10000000, 0b00000000, 0b00000000, 0b00001100, 0b00101000, 0b00000000));
+
+    run_one_scan_loop();
+    EXPECT_EQ(serial_output.size(), 12);
+    EXPECT_EQ(steno_output_queue_pending(), 0);
+}
+
+TEST_F(Steno, FullQueueSendsTheOldestStrokes) {
+    TestDriver                        driver;
+    std::vector<std::vector<uint8_t>> packets;
+
+    // Each stroke has a different first key, so every packet can be told apart
+    for (uint16_t key = STN_S1; key <= STN_ZR; key++) {
+        size_t sent = serial_output.size();
+        stroke({STN_E, key});
+        while (steno_output_queue_task()) {
+        }
+        packets.push_back(std::vector<uint8_t>(serial_output.begin() + sent, serial_output.end()));
+    }
+
+    serial_output.clear();
+    for (uint16_t key = STN_S1; key <= STN_ZR; key++) {
+        stroke({STN_E, key});
+    }
+    EXPECT_LE(steno_output_queue_pending(), STENO_OUTPUT_QUEUE_SIZE);
+    idle_for(STENO_OUTPUT_QUEUE_SIZE);
+    EXPECT_EQ(steno_output_queue_pending(), 0);
+
+    std::vector<uint8_t> expected;
+    for (auto &packet : packets) {
+        expected.insert(expected.end(), packet.begin(), packet.end());
+    }
+    EXPECT_EQ(serial_output, expected);
+}
+#endif
+
+TEST_F(Steno, Benchmark) {
+    TestDriver driver;
+    const int  strokes = 100000;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < strokes; i++) {
+        stroke({STN_TL, STN_PL, STN_A, STN_E, STN_FR, STN_DR});
+        if (serial_output.size() > 1024) {
+            serial_output.clear();
+        }
+#ifdef STENO_OUTPUT_QUEUE
+        steno_output_queue_task();
+#endif
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    printf("%.0f ns per stroke, %.0f strokes per second\n", elapsed * 1e9 / strokes, strokes / elapsed);
+}
@@ -0,0 +1,16 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+#include "tap_dance_defs.h"
+
+// clang-format off
+tap_dance_action_t tap_dance_actions[TD_COUNT] = {
+    [TD_A_B] = ACTION_TAP_DANCE_DOUBLE(KC_A, KC_B),
+    [TD_C_D] = ACTION_TAP_DANCE_DOUBLE(KC_C, KC_D),
+    [TD_E_F] = ACTION_TAP_DANCE_DOUBLE(KC_E, KC_F),
+    [TD_G_H] = ACTION_TAP_DANCE_DOUBLE(KC_G, KC_H),
+    // Many more tap dances, which do not need any RAM for their state
+    [TD_G_H + 1 ... TD_COUNT - 1] = ACTION_TAP_DANCE_DOUBLE(KC_Y, KC_Z),
+};
+// clang-format on
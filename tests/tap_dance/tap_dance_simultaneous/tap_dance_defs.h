@@ -0,0 +1,20 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum tap_dance_ids {
+    TD_A_B, // ACTION_TAP_DANCE_DOUBLE(KC_A, KC_B)
+    TD_C_D, // ACTION_TAP_DANCE_DOUBLE(KC_C, KC_D)
+    TD_E_F, // ACTION_TAP_DANCE_DOUBLE(KC_E, KC_F)
+    TD_G_H, // ACTION_TAP_DANCE_DOUBLE(KC_G, KC_H)
+    TD_COUNT = 128,
+};
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,164 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "action_tapping.h"
+#include "test_keymap_key.hpp"
+#include "tap_dance_defs.h"
+
+using testing::_;
+using testing::InSequence;
+
+class TapDanceSimultaneous : public TestFixture {};
+
+TEST_F(TapDanceSimultaneous, StateIsOnlyHeldWhileInFlight) {
+    TestDriver driver;
+    auto       key_a_b = KeymapKey{0, 0, 0, TD(TD_A_B)};
+
+    set_keymap({key_a_b});
+
+    EXPECT_EQ(tap_dance_get_state(TD_A_B), nullptr);
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_a_b);
+    VERIFY_AND_CLEAR(driver);
+
+    tap_dance_state_t *state = tap_dance_get_state(TD_A_B);
+    ASSERT_NE(state, nullptr);
+    EXPECT_EQ(state->count, 1);
+    EXPECT_EQ(TAP_DANCE_KEYCODE(state), TD(TD_A_B));
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(TAPPING_TERM + 1);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(tap_dance_get_state(TD_A_B), nullptr);
+}
+
+TEST_F(TapDanceSimultaneous, HeldDancesOverlap) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_a_b = KeymapKey{0, 0, 0, TD(TD_A_B)};
+    auto       key_c_d = KeymapKey{0, 1, 0, TD(TD_C_D)};
+
+    set_keymap({key_a_b, key_c_d});
+
+    EXPECT_REPORT(driver, (KC_A));
+    key_a_b.press();
+    run_one_scan_loop();
+    idle_for(TAPPING_TERM);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A, KC_C));
+    key_c_d.press();
+    run_one_scan_loop();
+    idle_for(TAPPING_TERM);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NE(tap_dance_get_state(TD_A_B), nullptr);
+    EXPECT_NE(tap_dance_get_state(TD_C_D), nullptr);
+
+    EXPECT_REPORT(driver, (KC_C));
+    EXPECT_EMPTY_REPORT(driver);
+    key_a_b.release();
+    run_one_scan_loop();
+    key_c_d.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(tap_dance_get_state(TD_A_B), nullptr);
+    EXPECT_EQ(tap_dance_get_state(TD_C_D), nullptr);
+}
+
+TEST_F(TapDanceSimultaneous, DanceInterruptedWhileAnotherIsHeld) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_a_b = KeymapKey{0, 0, 0, TD(TD_A_B)};
+    auto       key_c_d = KeymapKey{0, 1, 0, TD(TD_C_D)};
+    auto       key_e_f = KeymapKey{0, 2, 0, TD(TD_E_F)};
+
+    set_keymap({key_a_b, key_c_d, key_e_f});
+
+    EXPECT_REPORT(driver, (KC_A));
+    key_a_b.press();
+    run_one_scan_loop();
+    idle_for(TAPPING_TERM);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // Double tapping C_D is interrupted by E_F, which finishes and resets it right away
+    EXPECT_REPORT(driver, (KC_A, KC_C));
+    EXPECT_REPORT(driver, (KC_A));
+    tap_key(key_c_d);
+    tap_key(key_e_f);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A, KC_E));
+    EXPECT_REPORT(driver, (KC_A));
+    idle_for(TAPPING_TERM + 1);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_a_b.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(TapDanceSimultaneous, DancesBeyondTheLimitAreIgnored) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_a_b  = KeymapKey{0, 0, 0, TD(TD_A_B)};
+    auto       key_c_d  = KeymapKey{0, 1, 0, TD(TD_C_D)};
+    auto       key_e_f  = KeymapKey{0, 2, 0, TD(TD_E_F)};
+    auto       key_g_h  = KeymapKey{0, 3, 0, TD(TD_G_H)};
+    auto       key_last = KeymapKey{0, 4, 0, TD(TD_COUNT - 1)};
+
+    set_keymap({key_a_b, key_c_d, key_e_f, key_g_h, key_last});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_REPORT(driver, (KC_A, KC_C));
+    EXPECT_REPORT(driver, (KC_A, KC_C, KC_E));
+    key_a_b.press();
+    run_one_scan_loop();
+    idle_for(TAPPING_TERM);
+    run_one_scan_loop();
+    key_c_d.press();
+    run_one_scan_loop();
+    idle_for(TAPPING_TERM);
+    run_one_scan_loop();
+    key_e_f.press();
+    run_one_scan_loop();
+    idle_for(TAPPING_TERM);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // All TAP_DANCE_MAX_SIMULTANEOUS states are in use
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_g_h);
+    idle_for(TAPPING_TERM + 1);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(tap_dance_get_state(TD_G_H), nullptr);
+
+    // Releasing one frees its state for the next
+    EXPECT_REPORT(driver, (KC_C, KC_E));
+    EXPECT_REPORT(driver, (KC_C, KC_E, KC_Z));
+    EXPECT_REPORT(driver, (KC_C, KC_E));
+    key_a_b.release();
+    run_one_scan_loop();
+    tap_key(key_last);
+    tap_key(key_last);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_E));
+    EXPECT_EMPTY_REPORT(driver);
+    key_c_d.release();
+    run_one_scan_loop();
+    key_e_f.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
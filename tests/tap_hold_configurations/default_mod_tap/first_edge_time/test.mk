@@ -0,0 +1,5 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+# Same tap-hold behaviour as without first edge times
+SRC += ../test_tap_hold.cpp
@@ -0,0 +1,181 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <functional>
+#include <vector>
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "action_tapping.h"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+extern "C" {
+void advance_time(uint32_t ms);
+}
+
+/* Work that runs inside the next housekeeping task, i.e. after the matrix has
+ * already been scanned, the same way an RGB render or OLED flush would. */
+static std::function<void(void)> busy_work;
+
+extern "C" void housekeeping_task_user(void) {
+    if (busy_work) {
+        auto work = busy_work;
+        busy_work = nullptr;
+        work();
+    }
+}
+
+/* Each test runs the same physical key sequence twice, once with a responsive
+ * main loop and once with a loop that stalls for longer than the tapping term
+ * right after the scan, and expects the same reports from both. */
+class SlowLoopTapHold : public ::testing::WithParamInterface<bool>, public TestFixture {
+   protected:
+    bool slow_loop;
+
+    void SetUp() override {
+        slow_loop = GetParam();
+        busy_work = nullptr;
+    }
+
+    void TearDown() override {
+        busy_work = nullptr;
+    }
+
+    struct Edge {
+        unsigned                  delay;
+        std::function<void(void)> action;
+    };
+
+    /* Performs each edge `delay` ms after the previous one. A responsive loop
+     * scans every edge as it happens, a slow loop performs all of them while
+     * stalled in housekeeping and only scans them TAPPING_TERM ms later. */
+    void run_edges(std::vector<Edge> edges) {
+        if (slow_loop) {
+            busy_work = [=]() {
+                for (auto& edge : edges) {
+                    advance_time(edge.delay);
+                    edge.action();
+                }
+                advance_time(TAPPING_TERM);
+            };
+            run_one_scan_loop();
+            run_one_scan_loop();
+        } else {
+            for (auto& edge : edges) {
+                idle_for(edge.delay);
+                edge.action();
+                run_one_scan_loop();
+            }
+        }
+    }
+};
+
+TEST_P(SlowLoopTapHold, tap_mod_tap_key) {
+    TestDriver driver;
+    InSequence s;
+    auto       mod_tap_hold_key = KeymapKey(0, 1, 0, SFT_T(KC_P));
+
+    set_keymap({mod_tap_hold_key});
+
+    /* Press mod-tap-hold key. */
+    EXPECT_NO_REPORT(driver);
+    mod_tap_hold_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    /* Release mod-tap-hold key well within the tapping term. */
+    EXPECT_REPORT(driver, (KC_P));
+    EXPECT_EMPTY_REPORT(driver);
+    run_edges({{TAPPING_TERM / 2, [&]() { mod_tap_hold_key.release(); }}});
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_P(SlowLoopTapHold, hold_mod_tap_key) {
+    TestDriver driver;
+    InSequence s;
+    auto       mod_tap_hold_key = KeymapKey(0, 1, 0, SFT_T(KC_P));
+
+    set_keymap({mod_tap_hold_key});
+
+    /* Press mod-tap-hold key. */
+    EXPECT_NO_REPORT(driver);
+    mod_tap_hold_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    /* Hold it past the tapping term. */
+    EXPECT_REPORT(driver, (KC_LSFT));
+    run_edges({{TAPPING_TERM + 1, []() {}}});
+    VERIFY_AND_CLEAR(driver);
+
+    /* Release mod-tap-hold key. */
+    EXPECT_EMPTY_REPORT(driver);
+    mod_tap_hold_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_P(SlowLoopTapHold, press_regular_key_and_release_mod_tap_key) {
+    TestDriver driver;
+    InSequence s;
+    auto       regular_key      = KeymapKey(0, 0, 0, KC_A);
+    auto       mod_tap_hold_key = KeymapKey(0, 1, 0, SFT_T(KC_P));
+
+    set_keymap({regular_key, mod_tap_hold_key});
+
+    /* Press mod-tap-hold key. */
+    EXPECT_NO_REPORT(driver);
+    mod_tap_hold_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    /* Press regular key, then release mod-tap-hold key within the tapping term. */
+    EXPECT_REPORT(driver, (KC_P));
+    EXPECT_REPORT(driver, (KC_P, KC_A));
+    EXPECT_REPORT(driver, (KC_A));
+    run_edges({{TAPPING_TERM / 4, [&]() { regular_key.press(); }}, {TAPPING_TERM / 4, [&]() { mod_tap_hold_key.release(); }}});
+    VERIFY_AND_CLEAR(driver);
+
+    /* Release regular key. */
+    EXPECT_EMPTY_REPORT(driver);
+    regular_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_P(SlowLoopTapHold, press_regular_key_in_same_row_and_hold_mod_tap_key) {
+    TestDriver driver;
+    InSequence s;
+    auto       regular_key      = KeymapKey(0, 0, 0, KC_A);
+    auto       mod_tap_hold_key = KeymapKey(0, 1, 0, SFT_T(KC_P));
+
+    set_keymap({regular_key, mod_tap_hold_key});
+
+    /* Press mod-tap-hold key. */
+    EXPECT_NO_REPORT(driver);
+    mod_tap_hold_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    /* Press regular key within the tapping term, then release mod-tap-hold key
+     * after it. The release keeps its own time even though another key in the
+     * same row changed first. */
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_REPORT(driver, (KC_LSFT, KC_A));
+    EXPECT_REPORT(driver, (KC_A));
+    run_edges({{TAPPING_TERM / 2, [&]() { regular_key.press(); }}, {TAPPING_TERM / 2 + 10, [&]() { mod_tap_hold_key.release(); }}});
+    VERIFY_AND_CLEAR(driver);
+
+    /* Release regular key. */
+    EXPECT_EMPTY_REPORT(driver);
+    regular_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+INSTANTIATE_TEST_CASE_P(MainLoop, SlowLoopTapHold, ::testing::Values(false, true), [](const ::testing::TestParamInfo<bool>& info) { return info.param ? "Slow" : "Fast"; });
@@ -0,0 +1,165 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keycode.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "task_profiler.h"
+void advance_time(uint32_t ms);
+}
+
+using testing::_;
+using testing::AnyNumber;
+
+/* Handling KC_B stalls the matrix task for the given number of milliseconds. */
+static uint32_t slow_key_ms = 0;
+
+extern "C" bool process_record_user(uint16_t keycode, keyrecord_t *record) {
+    if (keycode == KC_B && record->event.pressed) {
+        advance_time(slow_key_ms);
+    }
+    return true;
+}
+
+static uint32_t read_u32(const uint8_t *data) {
+    return ((uint32_t)data[0] << 24) | ((uint32_t)data[1] << 16) | ((uint32_t)data[2] << 8) | data[3];
+}
+
+class TaskProfiler : public TestFixture {
+   protected:
+    void SetUp() override {
+        slow_key_ms = 5;
+        task_profiler_reset();
+    }
+};
+
+TEST_F(TaskProfiler, CountsEveryLoop) {
+    TestDriver driver;
+
+    idle_for(100);
+
+    EXPECT_EQ(task_profiler_get_stats(TASK_PROFILER_KEYBOARD)->count, 100);
+    EXPECT_EQ(task_profiler_get_stats(TASK_PROFILER_MATRIX)->count, 100);
+    EXPECT_EQ(task_profiler_get_stats(TASK_PROFILER_QUANTUM)->count, 100);
+    EXPECT_EQ(task_profiler_get_stats(TASK_PROFILER_LED)->count, 100);
+    EXPECT_EQ(task_profiler_get_stats(TASK_PROFILER_MATRIX)->max_us, 0);
+    EXPECT_EQ(task_profiler_get_stats(TASK_PROFILER_MATRIX)->histogram[0], 100);
+}
+
+TEST_F(TaskProfiler, AccountsSlowKeyHandlerToMatrixTask) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, KC_B);
+
+    set_keymap({key});
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+
+    idle_for(98);
+    key.press();
+    run_one_scan_loop();
+    key.release();
+    run_one_scan_loop();
+
+    const task_profiler_stats_t *matrix = task_profiler_get_stats(TASK_PROFILER_MATRIX);
+    EXPECT_EQ(matrix->count, 100);
+    EXPECT_EQ(matrix->min_us, 0);
+    EXPECT_EQ(matrix->max_us, 5000);
+    EXPECT_EQ(task_profiler_get_avg(TASK_PROFILER_MATRIX), 50);
+    // 5000us falls into [4096, 8192)
+    EXPECT_EQ(matrix->histogram[13], 1);
+    EXPECT_EQ(matrix->histogram[0], 99);
+    // A single outlier in a hundred calls is still within the 99th percentile
+    EXPECT_EQ(task_profiler_get_p99(TASK_PROFILER_MATRIX), 0);
+
+    // The enclosing loop sees the stall too, but is never blamed for it
+    EXPECT_EQ(task_profiler_get_stats(TASK_PROFILER_KEYBOARD)->max_us, 5000);
+    uint32_t             worst_us = 0;
+    task_profiler_task_t worst    = task_profiler_get_worst(&worst_us, NULL);
+    EXPECT_EQ(worst, TASK_PROFILER_MATRIX);
+    EXPECT_EQ(worst_us, 5000);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(TaskProfiler, P99FollowsFrequentStalls) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, KC_B);
+
+    set_keymap({key});
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+
+    slow_key_ms = 3;
+    for (int i = 0; i < 10; i++) {
+        key.press();
+        run_one_scan_loop();
+        key.release();
+        idle_for(9);
+    }
+
+    // 3000us falls into [2048, 4096), the upper bound is capped at the maximum
+    EXPECT_EQ(task_profiler_get_stats(TASK_PROFILER_MATRIX)->histogram[12], 10);
+    EXPECT_EQ(task_profiler_get_p99(TASK_PROFILER_MATRIX), 3000);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(TaskProfiler, ResetClearsEverything) {
+    TestDriver driver;
+
+    idle_for(10);
+    task_profiler_reset();
+
+    EXPECT_EQ(task_profiler_get_stats(TASK_PROFILER_MATRIX)->count, 0);
+    EXPECT_EQ(task_profiler_get_avg(TASK_PROFILER_MATRIX), 0);
+    EXPECT_EQ(task_profiler_get_p99(TASK_PROFILER_MATRIX), 0);
+    EXPECT_EQ(task_profiler_get_worst(NULL, NULL), TASK_PROFILER_TASK_COUNT);
+}
+
+TEST_F(TaskProfiler, RawHidQueries) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, KC_B);
+
+    set_keymap({key});
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+
+    idle_for(9);
+    key.press();
+    run_one_scan_loop();
+    key.release();
+    run_one_scan_loop();
+
+    uint8_t data[32] = {TASK_PROFILER_RAW_HID_COMMAND, id_task_profiler_get_task_count};
+    EXPECT_TRUE(task_profiler_raw_hid_receive(data, sizeof(data)));
+    EXPECT_EQ(data[2], TASK_PROFILER_TASK_COUNT);
+
+    uint8_t name[32] = {TASK_PROFILER_RAW_HID_COMMAND, id_task_profiler_get_task_name, TASK_PROFILER_MATRIX};
+    task_profiler_raw_hid_receive(name, sizeof(name));
+    EXPECT_STREQ((const char *)&name[3], "matrix");
+
+    uint8_t stats[32] = {TASK_PROFILER_RAW_HID_COMMAND, id_task_profiler_get_stats, TASK_PROFILER_MATRIX};
+    task_profiler_raw_hid_receive(stats, sizeof(stats));
+    EXPECT_EQ(read_u32(&stats[3]), 11);
+    EXPECT_EQ(read_u32(&stats[7]), 0);
+    EXPECT_EQ(read_u32(&stats[11]), 5000 / 11);
+    EXPECT_EQ(read_u32(&stats[19]), 5000);
+
+    uint8_t histogram[32] = {TASK_PROFILER_RAW_HID_COMMAND, id_task_profiler_get_histogram, TASK_PROFILER_MATRIX};
+    task_profiler_raw_hid_receive(histogram, sizeof(histogram));
+    EXPECT_EQ((histogram[3] << 8) | histogram[4], 10);
+    EXPECT_EQ((histogram[3 + 13 * 2] << 8) | histogram[3 + 13 * 2 + 1], 1);
+
+    uint8_t worst[32] = {TASK_PROFILER_RAW_HID_COMMAND, id_task_profiler_get_worst};
+    task_profiler_raw_hid_receive(worst, sizeof(worst));
+    EXPECT_EQ(worst[2], TASK_PROFILER_MATRIX);
+    EXPECT_EQ(read_u32(&worst[3]), 5000);
+
+    uint8_t unknown[32] = {TASK_PROFILER_RAW_HID_COMMAND, 0x42};
+    task_profiler_raw_hid_receive(unknown, sizeof(unknown));
+    EXPECT_EQ(unknown[1], id_task_profiler_unhandled);
+
+    uint8_t other[32] = {0x01};
+    EXPECT_FALSE(task_profiler_raw_hid_receive(other, sizeof(other)));
+
+    uint8_t reset[32] = {TASK_PROFILER_RAW_HID_COMMAND, id_task_profiler_reset};
+    task_profiler_raw_hid_receive(reset, sizeof(reset));
+    EXPECT_EQ(task_profiler_get_stats(TASK_PROFILER_MATRIX)->count, 0);
+    VERIFY_AND_CLEAR(driver);
+}
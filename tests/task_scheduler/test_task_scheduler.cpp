@@ -0,0 +1,206 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "task_scheduler.h"
+void advance_time(uint32_t ms);
+}
+
+using testing::_;
+using testing::InSequence;
+
+/* Every test task records its runs here, in order, and stalls for its configured duration. */
+static std::vector<char> runs;
+static uint32_t          fast_ms, slow_ms, hog_ms;
+static int               slices_left;
+
+static bool fast_task(void) {
+    runs.push_back('f');
+    advance_time(fast_ms);
+    return false;
+}
+
+static bool slow_task(void) {
+    runs.push_back('s');
+    advance_time(slow_ms);
+    return false;
+}
+
+static bool hog_task(void) {
+    runs.push_back('h');
+    advance_time(hog_ms);
+    return false;
+}
+
+static bool sliced_task(void) {
+    runs.push_back('c');
+    return --slices_left > 0;
+}
+
+class TaskScheduler : public TestFixture {
+   protected:
+    std::vector<task_scheduler_token> tokens;
+
+    void SetUp() override {
+        runs.clear();
+        fast_ms     = 0;
+        slow_ms     = 0;
+        hog_ms      = 0;
+        slices_left = 0;
+        task_scheduler_reset_stats();
+    }
+
+    void TearDown() override {
+        for (auto token : tokens) {
+            task_scheduler_unregister(token);
+        }
+    }
+
+    task_scheduler_token add(task_scheduler_callback_t callback, uint16_t period, uint8_t priority, uint16_t budget = 0) {
+        task_scheduler_token token = task_scheduler_register(callback, "test", period, priority, budget);
+        EXPECT_NE(token, INVALID_TASK_SCHEDULER_TOKEN);
+        tokens.push_back(token);
+        return token;
+    }
+
+    long count(char task) {
+        return std::count(runs.begin(), runs.end(), task);
+    }
+};
+
+TEST_F(TaskScheduler, RunsEveryPassWithinBudget) {
+    TestDriver driver;
+
+    add(fast_task, 0, TASK_SCHEDULER_PRIORITY_NORMAL);
+    add(slow_task, 0, TASK_SCHEDULER_PRIORITY_LOW);
+
+    idle_for(10);
+
+    EXPECT_EQ(count('f'), 10);
+    EXPECT_EQ(count('s'), 10);
+}
+
+TEST_F(TaskScheduler, RunsPeriodicTaskOncePerPeriod) {
+    TestDriver driver;
+
+    auto token = add(fast_task, 10, TASK_SCHEDULER_PRIORITY_NORMAL);
+
+    idle_for(100);
+
+    EXPECT_EQ(count('f'), 10);
+    EXPECT_EQ(task_scheduler_get_stats(token)->deadline_misses, 0);
+}
+
+TEST_F(TaskScheduler, StopsAtLoopBudgetInPriorityOrder) {
+    TestDriver driver;
+
+    fast_ms = TASK_SCHEDULER_LOOP_BUDGET;
+    slow_ms = TASK_SCHEDULER_LOOP_BUDGET;
+    add(slow_task, 0, TASK_SCHEDULER_PRIORITY_LOW);
+    add(fast_task, 0, TASK_SCHEDULER_PRIORITY_HIGH);
+
+    /* Only one of the tasks fits in each pass, the higher priority wins. */
+    run_one_scan_loop();
+    EXPECT_EQ(runs, std::vector<char>({'f'}));
+    run_one_scan_loop();
+    EXPECT_EQ(runs, std::vector<char>({'f', 'f'}));
+
+    /* Once the budget allows, both run again. */
+    fast_ms = 0;
+    run_one_scan_loop();
+    EXPECT_EQ(runs, std::vector<char>({'f', 'f', 'f', 's'}));
+}
+
+TEST_F(TaskScheduler, KeyIsReportedWhileBackgroundTaskStalls) {
+    TestDriver driver;
+    InSequence s;
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key});
+    hog_ms = 20;
+    add(hog_task, 0, TASK_SCHEDULER_PRIORITY_HIGH);
+
+    /* The matrix is serviced before the hog on every pass. */
+    EXPECT_REPORT(driver, (KC_A));
+    key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    hog_ms = 0;
+}
+
+TEST_F(TaskScheduler, ReportsAndPromotesStarvedTask) {
+    TestDriver driver;
+
+    hog_ms    = 4;
+    auto hog  = add(hog_task, 0, TASK_SCHEDULER_PRIORITY_HIGH);
+    auto slow = add(slow_task, 0, TASK_SCHEDULER_PRIORITY_IDLE);
+
+    /* The hog uses up the loop budget every pass, until the starved task
+     * passes its deadline and gets to run first. */
+    for (int i = 0; i < 6; i++) {
+        run_one_scan_loop();
+    }
+    EXPECT_GE(count('s'), 1);
+    EXPECT_EQ(task_scheduler_get_stats(slow)->deadline_misses, 1);
+    EXPECT_GT(task_scheduler_get_stats(slow)->max_lateness, TASK_SCHEDULER_STARVATION_LIMIT);
+    EXPECT_EQ(task_scheduler_get_stats(hog)->deadline_misses, 0);
+
+    hog_ms = 0;
+}
+
+TEST_F(TaskScheduler, ResumesTaskWithPendingWork) {
+    TestDriver driver;
+
+    slices_left = 3;
+    add(sliced_task, 50, TASK_SCHEDULER_PRIORITY_NORMAL);
+
+    /* One slice per pass until the job is done, then wait for the next period. */
+    idle_for(3);
+    EXPECT_EQ(count('c'), 3);
+    idle_for(40);
+    EXPECT_EQ(count('c'), 3);
+
+    slices_left = 1;
+    idle_for(10);
+    EXPECT_EQ(count('c'), 4);
+}
+
+TEST_F(TaskScheduler, CountsBudgetOverruns) {
+    TestDriver driver;
+
+    slow_ms    = 3;
+    auto token = add(slow_task, 0, TASK_SCHEDULER_PRIORITY_NORMAL, 2);
+
+    run_one_scan_loop();
+    slow_ms = 1;
+    run_one_scan_loop();
+
+    EXPECT_EQ(task_scheduler_get_stats(token)->runs, 2);
+    EXPECT_EQ(task_scheduler_get_stats(token)->budget_overruns, 1);
+    EXPECT_EQ(task_scheduler_get_stats(token)->max_duration, 3);
+}
+
+TEST_F(TaskScheduler, StopsRunningUnregisteredTask) {
+    TestDriver driver;
+
+    auto token = add(fast_task, 0, TASK_SCHEDULER_PRIORITY_NORMAL);
+    idle_for(5);
+    EXPECT_TRUE(task_scheduler_unregister(token));
+    EXPECT_FALSE(task_scheduler_unregister(token));
+    EXPECT_EQ(task_scheduler_get_stats(token), nullptr);
+    idle_for(5);
+
+    EXPECT_EQ(count('f'), 5);
+}
@@ -16,16 +16,39 @@
 
 #include "matrix.h"
 #include "test_matrix.h"
+#include "timer.h"
+#ifdef MATRIX_IDLE_WAIT_ENABLE
+#    include "wakeup.h"
+#endif
 #include <string.h>
 
 static matrix_row_t matrix[MATRIX_ROWS] = {};
 
+// Switches are "sampled" the moment they are pressed or released, which lets
+// tests model edges that happen while the main loop is busy elsewhere
+#ifdef MATRIX_FIRST_EDGE_TIME
+static uint16_t     key_time[MATRIX_ROWS][MATRIX_COLS] = {};
+static matrix_row_t key_pending[MATRIX_ROWS]           = {};
+
+static void stamp_key(uint8_t row, uint8_t col) {
+    if (!(key_pending[row] & ((matrix_row_t)1 << col))) {
+        key_pending[row] |= (matrix_row_t)1 << col;
+        key_time[row][col] = timer_read();
+    }
+}
+#else
+#    define stamp_key(row, col)
+#endif
+
 void matrix_init(void) {
     clear_all_keys();
     matrix_init_kb();
 }
 
 uint8_t matrix_scan(void) {
+#ifdef MATRIX_FIRST_EDGE_TIME
+    memset(key_pending, 0, sizeof(key_pending));
+#endif
     matrix_scan_kb();
     return 1;
 }
@@ -34,17 +57,31 @@ matrix_row_t matrix_get_row(uint8_t row) {
     return matrix[row];
 }
 
+#ifdef MATRIX_FIRST_EDGE_TIME
+uint16_t matrix_get_key_time(uint8_t row, uint8_t col) {
+    return key_time[row][col];
+}
+#endif
+
 void matrix_print(void) {}
 
+#ifdef MATRIX_IDLE_WAIT_ENABLE
+bool matrix_idle_wait(uint32_t timeout_ms) {
+    return wakeup_wait(timeout_ms);
+}
+#endif
+
 void matrix_init_kb(void) {}
 
 void matrix_scan_kb(void) {}
 
 void press_key(uint8_t col, uint8_t row) {
+    stamp_key(row, col);
     matrix[row] |= (matrix_row_t)1 << col;
 }
 
 void release_key(uint8_t col, uint8_t row) {
+    stamp_key(row, col);
     matrix[row] &= ~((matrix_row_t)1 << col);
 }
 
@@ -53,6 +90,13 @@ bool matrix_is_on(uint8_t row, uint8_t col) {
 }
 
 void clear_all_keys(void) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            if (matrix[row] & ((matrix_row_t)1 << col)) {
+                stamp_key(row, col);
+            }
+        }
+    }
     memset(matrix, 0, sizeof(matrix));
 }
 
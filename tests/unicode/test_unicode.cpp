@@ -84,3 +84,48 @@ TEST_F(Unicode, sends_unicode_string) {
 
     VERIFY_AND_CLEAR(driver);
 }
+
+TEST_F(Unicode, sends_unicode_string_in_one_input_for_macos) {
+    TestDriver driver;
+
+    set_unicode_input_mode(UNICODE_MODE_MACOS);
+
+    {
+        testing::InSequence s;
+
+        // Alt+03A8 Ψ, then D83EDDD9 🧙 without releasing Alt
+        EXPECT_REPORT(driver, (KC_LEFT_ALT));
+        for (uint16_t digit : {KC_0, KC_3, KC_A, KC_8, KC_D, KC_8, KC_3, KC_E, KC_D, KC_D, KC_D, KC_9}) {
+            EXPECT_REPORT(driver, (digit, KC_LEFT_ALT));
+            EXPECT_REPORT(driver, (KC_LEFT_ALT));
+        }
+        EXPECT_EMPTY_REPORT(driver);
+    }
+
+    send_unicode_string("Ψ🧙");
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(Unicode, skips_code_points_the_mode_cannot_send) {
+    TestDriver driver;
+
+    set_unicode_input_mode(UNICODE_MODE_MACOS);
+
+    {
+        testing::InSequence s;
+
+        EXPECT_REPORT(driver, (KC_LEFT_ALT));
+        for (uint16_t digit : {KC_0, KC_3, KC_A, KC_8}) {
+            EXPECT_REPORT(driver, (digit, KC_LEFT_ALT));
+            EXPECT_REPORT(driver, (KC_LEFT_ALT));
+        }
+        EXPECT_EMPTY_REPORT(driver);
+    }
+
+    // An invalid UTF-8 byte is dropped without opening an input
+    send_unicode_string("\xFF");
+    send_unicode_string("\xFFΨ");
+
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,42 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstdio>
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+
+/* Twenty code points from the Greek block, all four hex digits long. */
+#define GREEK_TEXT "αβγδεζηθικλμνξοπρστυ"
+#define GREEK_CODE_POINTS 20
+
+class UnicodeThroughput : public TestFixture {
+   protected:
+    unsigned reports_per_code_point(uint8_t mode, const char *name) {
+        TestDriver driver;
+        unsigned   reports = 0;
+
+        set_unicode_input_mode(mode);
+        EXPECT_ANY_REPORT(driver).WillRepeatedly([&reports](report_keyboard_t &) { reports++; });
+        uint32_t start = timer_read32();
+        send_unicode_string(GREEK_TEXT);
+        uint32_t elapsed = timer_elapsed32(start);
+        VERIFY_AND_CLEAR(driver);
+
+        printf("%-10s %.1f reports, %.1f ms per code point\n", name, (double)reports / GREEK_CODE_POINTS, (double)elapsed / GREEK_CODE_POINTS);
+        return reports;
+    }
+};
+
+TEST_F(UnicodeThroughput, ReportsPerCodePoint) {
+    // Hold Alt, then tap and release four digits per code point
+    EXPECT_EQ(reports_per_code_point(UNICODE_MODE_MACOS, "macOS"), 1 + GREEK_CODE_POINTS * 4 * 2 + 1);
+
+    // Ctrl+Shift+U, four digits and Space for every code point
+    EXPECT_EQ(reports_per_code_point(UNICODE_MODE_LINUX, "Linux"), GREEK_CODE_POINTS * (4 + 4 * 2 + 2));
+
+    reports_per_code_point(UNICODE_MODE_WINCOMPOSE, "WinCompose");
+    reports_per_code_point(UNICODE_MODE_EMACS, "Emacs");
+}
@@ -16,11 +16,13 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
 #include <stdint.h>
+#include <string.h>
 #include "keyboard.h"
 #include "keycode.h"
 #include "host.h"
 #include "util.h"
 #include "debug.h"
+#include "timer.h"
 
 #ifdef DIGITIZER_ENABLE
 #    include "digitizer.h"
@@ -44,8 +46,15 @@ static host_driver_t *driver;
 static uint16_t       last_system_usage   = 0;
 static uint16_t       last_consumer_usage = 0;
 
+#ifdef HOST_REPORT_QUEUE_ENABLE
+static void report_queue_reset(void);
+#endif
+
 void host_set_driver(host_driver_t *d) {
     driver = d;
+#ifdef HOST_REPORT_QUEUE_ENABLE
+    report_queue_reset();
+#endif
 }
 
 host_driver_t *host_get_driver(void) {
@@ -71,6 +80,157 @@ led_t host_keyboard_led_state(void) {
     return (led_t)host_keyboard_leds();
 }
 
+static void driver_send_keyboard(report_keyboard_t *report) {
+    (*driver->send_keyboard)(report);
+
+    if (debug_keyboard) {
+        dprintf("keyboard_report: %02X | ", report->mods);
+        for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+            dprintf("%02X ", report->keys[i]);
+        }
+        dprint("\n");
+    }
+}
+
+#ifdef HOST_REPORT_QUEUE_ENABLE
+/* The slot at report_queue_sent holds the report the host currently sees, the
+ * pending ones follow it in order. Drivers are handed the slot itself and may
+ * keep using it until their transfer completes. A full queue hands its oldest
+ * report over before the previous transfer is due to finish, so the ring has
+ * one slot more than the queue holds, and the slot sent before the current one
+ * is never written straight away.
+ */
+#    define REPORT_QUEUE_SLOTS (HOST_REPORT_QUEUE_SIZE + 1)
+
+static report_keyboard_t report_queue[REPORT_QUEUE_SLOTS];
+static uint8_t           report_queue_sent         = 0;
+static uint8_t           report_queue_count        = 0;
+static uint16_t          report_queue_last_sent_at = 0;
+
+#    define REPORT_QUEUE_SLOT(offset) (&report_queue[(report_queue_sent + (offset)) % REPORT_QUEUE_SLOTS])
+
+static bool report_has_key(const report_keyboard_t *report, uint8_t key) {
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        if (report->keys[i] == key) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Whether `next` can be sent in place of `tail`, which follows `prev`, without
+ * the host missing anything: whatever tail pressed must still be held in next,
+ * and whatever it released must still be released. When tail pressed a key,
+ * next may not press another one or change the modifiers either, as the host
+ * would then see both at once and could apply them in the wrong order.
+ */
+static bool report_can_replace(const report_keyboard_t *prev, const report_keyboard_t *tail, const report_keyboard_t *next) {
+    uint8_t mods_pressed  = tail->mods & ~prev->mods;
+    uint8_t mods_released = prev->mods & ~tail->mods;
+    if ((mods_pressed & ~next->mods) || (mods_released & next->mods)) {
+        return false;
+    }
+
+    bool key_pressed = false;
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        uint8_t key = tail->keys[i];
+        if (key && !report_has_key(prev, key)) {
+            if (!report_has_key(next, key)) {
+                return false;
+            }
+            key_pressed = true;
+        }
+        key = prev->keys[i];
+        if (key && !report_has_key(tail, key) && report_has_key(next, key)) {
+            return false;
+        }
+    }
+
+    if (key_pressed) {
+        if (next->mods != tail->mods) {
+            return false;
+        }
+        for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+            if (next->keys[i] && !report_has_key(tail, next->keys[i])) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/* Reports queued for the previous driver are dropped, the new one can take the next report right away. */
+static void report_queue_reset(void) {
+    report_queue_count        = 0;
+    report_queue_last_sent_at = timer_read() - HOST_REPORT_QUEUE_INTERVAL;
+}
+
+static void report_queue_send_next(void) {
+    report_queue_sent = (report_queue_sent + 1) % REPORT_QUEUE_SLOTS;
+    report_queue_count--;
+    report_queue_last_sent_at = timer_read();
+    driver_send_keyboard(&report_queue[report_queue_sent]);
+}
+
+static void report_queue_push(report_keyboard_t *report) {
+    if (report_queue_count > 0) {
+        report_keyboard_t *tail = REPORT_QUEUE_SLOT(report_queue_count);
+        if (report_can_replace(REPORT_QUEUE_SLOT(report_queue_count - 1), tail, report)) {
+            memcpy(tail, report, sizeof(report_keyboard_t));
+            return;
+        }
+    }
+
+    if (report_queue_count == HOST_REPORT_QUEUE_SIZE - 1) {
+        // Hand the oldest report over early rather than dropping anything
+        dprintf("host: report queue full\n");
+        report_queue_send_next();
+    }
+
+    memcpy(REPORT_QUEUE_SLOT(report_queue_count + 1), report, sizeof(report_keyboard_t));
+    report_queue_count++;
+    host_report_queue_task();
+}
+
+void host_report_queue_task(void) {
+    if (report_queue_count > 0 && timer_elapsed(report_queue_last_sent_at) >= HOST_REPORT_QUEUE_INTERVAL) {
+        if (!driver) {
+            report_queue_count = 0;
+            return;
+        }
+        report_queue_send_next();
+    }
+}
+
+void host_report_queue_flush(void) {
+    while (driver && report_queue_count > 0) {
+        report_queue_send_next();
+    }
+    report_queue_count = 0;
+}
+
+uint8_t host_report_queue_pending(void) {
+    return report_queue_count;
+}
+
+uint32_t host_report_queue_time_until_next(void) {
+    if (report_queue_count == 0) {
+        return UINT32_MAX;
+    }
+    uint16_t elapsed = timer_elapsed(report_queue_last_sent_at);
+    return elapsed >= HOST_REPORT_QUEUE_INTERVAL ? 0 : HOST_REPORT_QUEUE_INTERVAL - elapsed;
+}
+#endif
+
+/* Keyboard reports still waiting in the queue go out before any other report,
+ * so the host sees e.g. a shift held before a mouse click in the same order.
+ */
+static inline void flush_keyboard_reports(void) {
+#ifdef HOST_REPORT_QUEUE_ENABLE
+    host_report_queue_flush();
+#endif
+}
+
 /* send report */
 void host_keyboard_send(report_keyboard_t *report) {
 #ifdef BLUETOOTH_ENABLE
@@ -84,19 +244,16 @@ void host_keyboard_send(report_keyboard_t *report) {
 #ifdef KEYBOARD_SHARED_EP
     report->report_id = REPORT_ID_KEYBOARD;
 #endif
-    (*driver->send_keyboard)(report);
-
-    if (debug_keyboard) {
-        dprintf("keyboard_report: %02X | ", report->mods);
-        for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
-            dprintf("%02X ", report->keys[i]);
-        }
-        dprint("\n");
-    }
+#ifdef HOST_REPORT_QUEUE_ENABLE
+    report_queue_push(report);
+#else
+    driver_send_keyboard(report);
+#endif
 }
 
 void host_nkro_send(report_nkro_t *report) {
     if (!driver) return;
+    flush_keyboard_reports();
     report->report_id = REPORT_ID_NKRO;
     (*driver->send_nkro)(report);
 
@@ -118,6 +275,7 @@ void host_mouse_send(report_mouse_t *report) {
 #endif
 
     if (!driver) return;
+    flush_keyboard_reports();
 #ifdef MOUSE_SHARED_EP
     report->report_id = REPORT_ID_MOUSE;
 #endif
@@ -134,6 +292,7 @@ void host_system_send(uint16_t usage) {
     last_system_usage = usage;
 
     if (!driver) return;
+    flush_keyboard_reports();
 
     report_extra_t report = {
         .report_id = REPORT_ID_SYSTEM,
@@ -154,6 +313,7 @@ void host_consumer_send(uint16_t usage) {
 #endif
 
     if (!driver) return;
+    flush_keyboard_reports();
 
     report_extra_t report = {
         .report_id = REPORT_ID_CONSUMER,
@@ -165,6 +325,7 @@ void host_consumer_send(uint16_t usage) {
 #ifdef JOYSTICK_ENABLE
 void host_joystick_send(joystick_t *joystick) {
     if (!driver) return;
+    flush_keyboard_reports();
 
     report_joystick_t report = {
 #    ifdef JOYSTICK_SHARED_EP
@@ -230,6 +391,7 @@ void host_digitizer_send(digitizer_t *digitizer) {
         .y        = (uint16_t)(digitizer->y * 0x7FFF),
     };
 
+    flush_keyboard_reports();
     send_digitizer(&report);
 }
 #endif
@@ -243,6 +405,7 @@ void host_programmable_button_send(uint32_t data) {
         .usage     = data,
     };
 
+    flush_keyboard_reports();
     send_programmable_button(&report);
 }
 #endif
@@ -27,6 +27,23 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 extern "C" {
 #endif
 
+#ifdef HOST_REPORT_QUEUE_ENABLE
+#    ifndef HOST_REPORT_QUEUE_SIZE
+#        define HOST_REPORT_QUEUE_SIZE 8
+#    endif
+#    if HOST_REPORT_QUEUE_SIZE < 2 || HOST_REPORT_QUEUE_SIZE > 255
+#        error HOST_REPORT_QUEUE_SIZE must be between 2 and 255
+#    endif
+
+#    ifndef HOST_REPORT_QUEUE_INTERVAL
+#        ifdef USB_POLLING_INTERVAL_MS
+#            define HOST_REPORT_QUEUE_INTERVAL USB_POLLING_INTERVAL_MS
+#        else
+#            define HOST_REPORT_QUEUE_INTERVAL 1
+#        endif
+#    endif
+#endif
+
 extern uint8_t keyboard_idle;
 extern uint8_t keyboard_protocol;
 
@@ -47,6 +64,28 @@ void    host_programmable_button_send(uint32_t data);
 uint16_t host_last_system_usage(void);
 uint16_t host_last_consumer_usage(void);
 
+#ifdef HOST_REPORT_QUEUE_ENABLE
+/**
+ * \brief Hands the next queued keyboard report to the driver once the previous one has been up for an interval.
+ */
+void host_report_queue_task(void);
+
+/**
+ * \brief Hands all queued keyboard reports to the driver right away.
+ */
+void host_report_queue_flush(void);
+
+/**
+ * \brief The number of keyboard reports waiting to be sent.
+ */
+uint8_t host_report_queue_pending(void);
+
+/**
+ * \brief The number of milliseconds until the next queued keyboard report is due, or UINT32_MAX if nothing is queued.
+ */
+uint32_t host_report_queue_time_until_next(void);
+#endif
+
 #ifdef __cplusplus
 }
 #endif